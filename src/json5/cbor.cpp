@@ -0,0 +1,29 @@
+#include "./cbor.hpp"
+
+#include <cmath>
+#include <string>
+
+void json5::detail::throw_cbor_error(std::string_view message, std::size_t offset) {
+    std::string what = "Error at CBOR input offset " + std::to_string(offset) + ": "
+        + std::string(message);
+    throw parse_error(what);
+}
+
+double json5::detail::decode_half_float(std::uint16_t bits) noexcept {
+    const int  exponent = (bits >> 10) & 0x1f;
+    const int  mantissa = bits & 0x3ff;
+    const bool negative = (bits & 0x8000) != 0;
+
+    double value = 0;
+    if (exponent == 0) {
+        // Subnormal
+        value = std::ldexp(mantissa, -24);
+    } else if (exponent != 31) {
+        value = std::ldexp(mantissa + 1024, exponent - 25);
+    } else if (mantissa == 0) {
+        value = INFINITY;
+    } else {
+        value = NAN;
+    }
+    return negative ? -value : value;
+}
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <json5/data.hpp>
+#include <json5/parse_data.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace json5 {
+
+/**
+ * Encoding and decoding of `basic_data` to and from CBOR (RFC 8949).
+ *
+ * Numbers with an integral value (other than -0.0) are encoded as CBOR integers, and all
+ * other numbers as a single-precision float if that represents them exactly, otherwise as a
+ * double-precision float. Decoding accepts any well-formed CBOR data item built of
+ * integers, floats, text strings, arrays, maps with text string keys, and the simple values
+ * `true`, `false`, `null`, and `undefined` (which decodes as null). Tags are skipped.
+ * Errors in decoding throw a `parse_error`.
+ */
+
+namespace detail {
+
+[[noreturn]] void throw_cbor_error(std::string_view message, std::size_t offset);
+
+double decode_half_float(std::uint16_t bits) noexcept;
+
+enum cbor_major : std::uint8_t {
+    cbor_uint       = 0,
+    cbor_negint     = 1,
+    cbor_bytes      = 2,
+    cbor_text       = 3,
+    cbor_array      = 4,
+    cbor_map        = 5,
+    cbor_tag        = 6,
+    cbor_simple     = 7,
+    cbor_indefinite = 31,
+};
+
+inline void cbor_put_uint(std::string& out, std::uint64_t value, int nbytes) {
+    for (int shift = (nbytes - 1) * 8; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xff));
+    }
+}
+
+inline void cbor_put_head(std::string& out, cbor_major major, std::uint64_t arg) {
+    const auto initial = static_cast<std::uint8_t>(major << 5);
+    if (arg < 24) {
+        out.push_back(static_cast<char>(initial | arg));
+    } else if (arg <= 0xff) {
+        out.push_back(static_cast<char>(initial | 24));
+        cbor_put_uint(out, arg, 1);
+    } else if (arg <= 0xffff) {
+        out.push_back(static_cast<char>(initial | 25));
+        cbor_put_uint(out, arg, 2);
+    } else if (arg <= 0xffff'ffff) {
+        out.push_back(static_cast<char>(initial | 26));
+        cbor_put_uint(out, arg, 4);
+    } else {
+        out.push_back(static_cast<char>(initial | 27));
+        cbor_put_uint(out, arg, 8);
+    }
+}
+
+inline void cbor_put_number(std::string& out, double value) {
+    constexpr double int_limit = 18446744073709551616.0;  // 2^64
+    // Negative zero is not an integer, or it would lose its sign
+    const bool negative_zero = value == 0 && std::signbit(value);
+    if (std::trunc(value) == value && std::abs(value) < int_limit && !negative_zero) {
+        if (value >= 0) {
+            cbor_put_head(out, cbor_uint, static_cast<std::uint64_t>(value));
+            return;
+        } else if (-(value + 1) < int_limit / 2) {
+            // Negative integers are encoded as `-1 - n`. Subtract in integer space, since
+            // `value + 1` may round for large magnitudes.
+            cbor_put_head(out, cbor_negint, static_cast<std::uint64_t>(-value) - 1);
+            return;
+        }
+    }
+    const auto as_float = static_cast<float>(value);
+    if (static_cast<double>(as_float) == value || std::isnan(value)) {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &as_float, sizeof bits);
+        out.push_back(static_cast<char>(0xfa));
+        cbor_put_uint(out, bits, 4);
+    } else {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof bits);
+        out.push_back(static_cast<char>(0xfb));
+        cbor_put_uint(out, bits, 8);
+    }
+}
+
+template <typename String>
+void cbor_put_text(std::string& out, const String& str) {
+    std::string_view view{str.data(), str.size()};
+    cbor_put_head(out, cbor_text, view.size());
+    out.append(view);
+}
+
+template <typename Data>
+void encode_cbor_inner(const Data& dat, std::string& out) {
+    if (dat.is_null()) {
+        out.push_back(static_cast<char>(0xf6));
+    } else if (dat.is_boolean()) {
+        out.push_back(static_cast<char>(dat.as_boolean() ? 0xf5 : 0xf4));
+    } else if (dat.is_number()) {
+        cbor_put_number(out, static_cast<double>(dat.as_number()));
+    } else if (dat.is_string()) {
+        cbor_put_text(out, dat.as_string());
+    } else if (dat.is_array()) {
+        const auto& arr = dat.as_array();
+        cbor_put_head(out, cbor_array, arr.size());
+        for (const auto& elem : arr) {
+            encode_cbor_inner(elem, out);
+        }
+    } else {
+        const auto& obj = dat.as_object();
+        cbor_put_head(out, cbor_map, obj.size());
+        for (const auto& [key, value] : obj) {
+            cbor_put_text(out, key);
+            encode_cbor_inner(value, out);
+        }
+    }
+}
+
+/**
+ * Reads CBOR data items from a byte buffer. Nesting is limited to the same depth as is
+ * allowed by the text parser.
+ */
+template <typename Data>
+class cbor_reader {
+    std::string_view _buf;
+    std::size_t      _pos   = 0;
+    std::size_t      _depth = 0;
+
+    constexpr static std::size_t max_depth = 1024;
+
+    std::uint8_t _byte() {
+        if (_pos == _buf.size()) {
+            throw_cbor_error("Unexpected end of CBOR data", _pos);
+        }
+        return static_cast<std::uint8_t>(_buf[_pos++]);
+    }
+
+    std::uint64_t _uint(int nbytes) {
+        std::uint64_t ret = 0;
+        for (; nbytes != 0; --nbytes) {
+            ret = (ret << 8) | _byte();
+        }
+        return ret;
+    }
+
+    /// Read the argument of a data item head with the given additional-information bits
+    std::uint64_t _argument(std::uint8_t info) {
+        if (info < 24) {
+            return info;
+        }
+        switch (info) {
+        case 24:
+            return _uint(1);
+        case 25:
+            return _uint(2);
+        case 26:
+            return _uint(4);
+        case 27:
+            return _uint(8);
+        default:
+            throw_cbor_error("Invalid CBOR additional information", _pos - 1);
+        }
+    }
+
+    /// Check that a declared item count is possible given the remaining input
+    std::size_t _count(std::uint64_t n) {
+        if (n > _buf.size() - _pos) {
+            throw_cbor_error("CBOR length exceeds the size of the input", _pos);
+        }
+        return static_cast<std::size_t>(n);
+    }
+
+    bool _at_break() {
+        if (_pos == _buf.size()) {
+            throw_cbor_error("Unterminated indefinite-length CBOR item", _pos);
+        }
+        if (static_cast<std::uint8_t>(_buf[_pos]) == 0xff) {
+            ++_pos;
+            return true;
+        }
+        return false;
+    }
+
+    template <typename String>
+    String _text(std::uint8_t info) {
+        if (info == cbor_indefinite) {
+            // A sequence of definite-length text string chunks
+            String ret;
+            while (!_at_break()) {
+                const auto head = _byte();
+                if ((head >> 5) != cbor_text || (head & 0x1f) == cbor_indefinite) {
+                    throw_cbor_error("Invalid chunk in indefinite-length CBOR text string",
+                                     _pos - 1);
+                }
+                auto chunk = _text<std::string>(head & 0x1f);
+                ret.append(chunk.data(), chunk.size());
+            }
+            return ret;
+        }
+        auto len   = _count(_argument(info));
+        auto start = _buf.data() + _pos;
+        _pos += len;
+        return String(start, len);
+    }
+
+    Data _array(std::uint8_t info) {
+        using array_type = typename Data::array_type;
+        array_type ret;
+        if (info == cbor_indefinite) {
+            while (!_at_break()) {
+                ret.push_back(read());
+            }
+        } else {
+            auto n = _count(_argument(info));
+            if constexpr (requires { ret.reserve(n); }) {
+                ret.reserve(n);
+            }
+            for (; n != 0; --n) {
+                ret.push_back(read());
+            }
+        }
+        return ret;
+    }
+
+    Data _map(std::uint8_t info) {
+        using object_type = typename Data::object_type;
+        using key_type    = typename object_type::key_type;
+        using mapped_type = typename object_type::mapped_type;
+        object_type ret;
+        auto        read_member = [&] {
+            const auto key_pos = _pos;
+            const auto head    = _byte();
+            if ((head >> 5) != cbor_text) {
+                throw_cbor_error("CBOR map keys must be text strings", key_pos);
+            }
+            auto key = _text<key_type>(head & 0x1f);
+            ret.emplace(std::move(key), static_cast<mapped_type>(read()));
+        };
+        if (info == cbor_indefinite) {
+            while (!_at_break()) {
+                read_member();
+            }
+        } else {
+            for (auto n = _count(_argument(info)); n != 0; --n) {
+                read_member();
+            }
+        }
+        return ret;
+    }
+
+    Data _simple(std::uint8_t info) {
+        using number_type = typename Data::number_type;
+        switch (info) {
+        case 20:
+            return typename Data::boolean_type(false);
+        case 21:
+            return typename Data::boolean_type(true);
+        case 22:
+        case 23:
+            return typename Data::null_type();
+        case 25:
+            return number_type(decode_half_float(static_cast<std::uint16_t>(_uint(2))));
+        case 26: {
+            const auto bits32 = static_cast<std::uint32_t>(_uint(4));
+            float      f      = 0;
+            std::memcpy(&f, &bits32, sizeof f);
+            return number_type(static_cast<double>(f));
+        }
+        case 27: {
+            const auto bits64 = _uint(8);
+            double     d      = 0;
+            std::memcpy(&d, &bits64, sizeof d);
+            return number_type(d);
+        }
+        default:
+            throw_cbor_error("Unsupported CBOR simple value", _pos - 1);
+        }
+    }
+
+public:
+    explicit cbor_reader(std::string_view buf)
+        : _buf(buf) {}
+
+    bool        done() const noexcept { return _pos == _buf.size(); }
+    std::size_t position() const noexcept { return _pos; }
+
+    /// Read the next complete data item
+    Data read() {
+        using number_type = typename Data::number_type;
+
+        const auto item_pos = _pos;
+        const auto head     = _byte();
+        const auto major    = static_cast<cbor_major>(head >> 5);
+        const auto info     = static_cast<std::uint8_t>(head & 0x1f);
+
+        if (_depth == max_depth) {
+            throw_cbor_error("Array/map nesting is too deep.", item_pos);
+        }
+        ++_depth;
+        struct depth_guard {
+            std::size_t& d;
+            ~depth_guard() { --d; }
+        } guard{_depth};
+
+        switch (major) {
+        case cbor_uint:
+            return number_type(static_cast<double>(_argument(info)));
+        case cbor_negint: {
+            // Add the one in integer space to avoid rounding twice
+            const auto arg = _argument(info);
+            if (arg == UINT64_MAX) {
+                return number_type(-18446744073709551616.0);  // -2^64
+            }
+            return number_type(-static_cast<double>(arg + 1));
+        }
+        case cbor_bytes:
+            throw_cbor_error("CBOR byte strings are not supported", item_pos);
+        case cbor_text:
+            return _text<typename Data::string_type>(info);
+        case cbor_array:
+            return _array(info);
+        case cbor_map:
+            return _map(info);
+        case cbor_tag:
+            // Tags carry no meaning for the JSON5 data model. Ignore them.
+            _argument(info);
+            return read();
+        case cbor_simple:
+        default:
+            return _simple(info);
+        }
+    }
+};
+
+}  // namespace detail
+
+/// Append the CBOR encoding of the given data to the output string
+template <typename Data>
+void encode_cbor(const Data& dat, std::string& out) {
+    detail::encode_cbor_inner(dat, out);
+}
+
+/// Obtain the CBOR encoding of the given data
+template <typename Data>
+std::string encode_cbor(const Data& dat) {
+    std::string ret;
+    encode_cbor(dat, ret);
+    return ret;
+}
+
+/// Decode a buffer containing exactly one CBOR data item
+template <typename Data = data>
+Data decode_cbor(std::string_view bytes) {
+    detail::cbor_reader<Data> reader{bytes};
+    auto                      ret = reader.read();
+    if (!reader.done()) {
+        detail::throw_cbor_error("Trailing bytes in CBOR data", reader.position());
+    }
+    return ret;
+}
+
+}  // namespace json5
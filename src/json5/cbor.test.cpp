@@ -0,0 +1,64 @@
+#include <json5/cbor.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+
+using namespace std::literals;
+
+TEST_CASE("Encode simple values as CBOR") {
+    CHECK(json5::encode_cbor(json5::data()) == "\xf6"sv);
+    CHECK(json5::encode_cbor(json5::data(true)) == "\xf5"sv);
+    CHECK(json5::encode_cbor(json5::data(0)) == "\x00"sv);
+    CHECK(json5::encode_cbor(json5::data(23)) == "\x17"sv);
+    CHECK(json5::encode_cbor(json5::data(500)) == "\x19\x01\xf4"sv);
+    CHECK(json5::encode_cbor(json5::data(-1)) == "\x20"sv);
+    CHECK(json5::encode_cbor(json5::data(1.5)) == "\xfa\x3f\xc0\x00\x00"sv);
+    CHECK(json5::encode_cbor(json5::data(1.1)) == "\xfb\x3f\xf1\x99\x99\x99\x99\x99\x9a"sv);
+    CHECK(json5::encode_cbor(json5::data("IETF")) == "\x64IETF"sv);
+    // Negative zero keeps its sign
+    CHECK(json5::encode_cbor(json5::data(-0.0)) == "\xfa\x80\x00\x00\x00"sv);
+}
+
+TEST_CASE("Decode CBOR") {
+    CHECK(json5::decode_cbor("\xf6"sv) == nullptr);
+    CHECK(json5::decode_cbor("\x19\x01\xf4"sv) == 500);
+    CHECK(json5::decode_cbor("\x38\x63"sv) == -100);
+    CHECK(json5::decode_cbor("\xf9\x3e\x00"sv) == 1.5);
+    CHECK(json5::decode_cbor("\x82\x01\x61\x61"sv) == json5::data::array_type({1, "a"}));
+    // Indefinite-length array and text string
+    CHECK(json5::decode_cbor("\x9f\x01\x7f\x61\x61\x61\x62\xff\xff"sv)
+          == json5::data::array_type({1, "ab"}));
+    // Tagged value
+    CHECK(json5::decode_cbor("\xc1\x1a\x51\x4b\x67\xb0"sv) == 1363896240);
+
+    CHECK_THROWS_AS(json5::decode_cbor(""sv), json5::parse_error);
+    CHECK_THROWS_AS(json5::decode_cbor("\x82\x01"sv), json5::parse_error);
+    CHECK_THROWS_AS(json5::decode_cbor("\x01\x01"sv), json5::parse_error);
+    CHECK_THROWS_AS(json5::decode_cbor("\x9b\xff\xff\xff\xff\xff\xff\xff\xff"sv),
+                    json5::parse_error);
+    CHECK_THROWS_AS(json5::decode_cbor("\xa1\x01\x02"sv), json5::parse_error);
+}
+
+TEST_CASE("CBOR round-trip") {
+    auto doc = json5::parse_data(R"({
+        name: 'vob-json5',
+        version: [0, 1, 6],
+        ratio: -2.25,
+        big: 123456789012,
+        flags: {debug: true, optimize: false, extra: null},
+    })");
+    CHECK(json5::decode_cbor(json5::encode_cbor(doc)) == doc);
+
+    const auto zero = json5::decode_cbor(json5::encode_cbor(json5::data(-0.0)));
+    CHECK(zero == 0);
+    CHECK(std::signbit(zero.as_number()));
+}
+
+TEST_CASE("CBOR integers beyond 2^53") {
+    constexpr double big = 9007199254740994.0;  // 2^53 + 2
+    CHECK(json5::encode_cbor(json5::data(big)) == "\x1b\x00\x20\x00\x00\x00\x00\x00\x02"sv);
+    CHECK(json5::encode_cbor(json5::data(-big)) == "\x3b\x00\x20\x00\x00\x00\x00\x00\x01"sv);
+    CHECK(json5::decode_cbor(json5::encode_cbor(json5::data(big))) == big);
+    CHECK(json5::decode_cbor(json5::encode_cbor(json5::data(-big))) == -big);
+}
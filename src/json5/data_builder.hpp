@@ -0,0 +1,184 @@
+#pragma once
+
+#include <json5/parse.hpp>
+#include <json5/parse_data.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace json5 {
+
+/// The amount of work that a single `data_builder::step()` may perform
+struct build_budget {
+    /// The maximum number of parse events to consume
+    std::size_t events = SIZE_MAX;
+    /// Stop once at least this many bytes of input have been consumed
+    std::size_t bytes = SIZE_MAX;
+};
+
+/// The state of a `data_builder` after a call to `step()`
+struct build_progress {
+    /// Whether the document has been completely built
+    bool done = false;
+    /// The number of events consumed by the step
+    std::size_t events = 0;
+    /// The number of bytes of input that have been consumed in total
+    std::size_t offset = 0;
+    /// The size of the input
+    std::size_t size = 0;
+
+    /// The portion of the input that has been consumed, from zero to one
+    double fraction() const noexcept {
+        return size ? static_cast<double>(offset) / static_cast<double>(size) : 1.0;
+    }
+};
+
+/**
+ * Builds data from a document in bounded steps, so that a large parse can be interleaved
+ * with other work. Each call to `step()` consumes input up to the given budget, and then
+ * returns. The value under construction is kept on an explicit stack between calls.
+ *
+ * The `presize_containers` option is not applied, because its pre-pass cannot be divided
+ * into steps.
+ *
+ * If a step throws `parse_error`, the builder is left in the done state, and has no result.
+ */
+template <typename Data = data>
+class data_builder {
+    using object_type = typename Data::mapping_type;
+    using key_type    = typename object_type::key_type;
+    using mapped_type = typename object_type::mapped_type;
+
+    /// An array or object that is under construction
+    struct frame {
+        Data value;
+        /// For an object, the key of the member whose value is under construction
+        key_type key;
+    };
+
+    std::string_view   _input;
+    parser             _parser;
+    std::vector<frame> _stack;
+    Data               _result;
+    bool               _have_root = false;
+    bool               _done      = false;
+
+    /// Add a complete value to the innermost container, or make it the result
+    void _attach(Data value, const token& tok) {
+        if (_stack.empty()) {
+            _result    = std::move(value);
+            _have_root = true;
+            return;
+        }
+        auto& top = _stack.back();
+        if (top.value.is_array()) {
+            detail::charge_allocation(_parser, sizeof(Data), tok);
+            top.value.as_array().push_back(std::move(value));
+        } else {
+            // The member was charged along with its key
+            top.value.as_object().emplace(std::move(top.key),
+                                          static_cast<mapped_type>(std::move(value)));
+        }
+    }
+
+    void _push(Data container) {
+        detail::update_stats(_parser.options(), [](parse_stats& stats) { ++stats.allocations; });
+        _stack.emplace_back().value = std::move(container);
+    }
+
+    void _pop(const token& tok) {
+        auto value = std::move(_stack.back().value);
+        _stack.pop_back();
+        _attach(std::move(value), tok);
+    }
+
+    void _handle(const parse_event& ev) {
+        using pek = parse_event::kind_t;
+        if (_have_root) {
+            // The root value is complete, and only the end of the input may follow
+            if (ev.kind != pek::eof) {
+                detail::throw_error("Trailing characters in JSON data", ev.token);
+            }
+            _done = true;
+            return;
+        }
+        switch (ev.kind) {
+        case pek::null_literal:
+        case pek::boolean_literal:
+        case pek::number_literal:
+        case pek::string_literal:
+            _attach(detail::parse_inner<Data>(_parser, ev), ev.token);
+            break;
+        case pek::array_begin:
+            _push(typename Data::array_type());
+            break;
+        case pek::object_begin:
+            _push(object_type());
+            break;
+        case pek::object_key:
+            _stack.back().key = detail::realize_member_key<key_type>(
+                _parser, ev.token, sizeof(typename object_type::value_type));
+            break;
+        case pek::array_end:
+        case pek::object_end:
+            _pop(ev.token);
+            break;
+        case pek::invalid:
+            detail::throw_error(_parser.error_message(), ev.token);
+        case pek::eof:
+            detail::throw_error("Unexpected end-of-input", ev.token);
+        default:
+            detail::throw_error("Invalid parse event sequence", ev.token);
+        }
+    }
+
+public:
+    explicit data_builder(std::string_view str, parse_options opts)
+        : _input(str)
+        , _parser(str, opts) {}
+
+    explicit data_builder(std::string_view str)
+        : data_builder(str, parse_options{}) {}
+
+    /// Consume input until the document is complete or the budget is spent
+    build_progress step(build_budget budget) {
+        build_progress ret;
+        const auto     start = _parser.offset();
+        try {
+            while (!_done && ret.events < budget.events
+                   && _parser.offset() - start < budget.bytes) {
+                _handle(_parser.next());
+                ++ret.events;
+            }
+        } catch (...) {
+            _done   = true;
+            _result = Data();
+            _stack.clear();
+            throw;
+        }
+        ret.done   = _done;
+        ret.offset = _parser.offset();
+        ret.size   = _input.size();
+        return ret;
+    }
+
+    /// Consume up to the given number of events
+    build_progress step(std::size_t max_events) { return step(build_budget{max_events}); }
+
+    /// Whether the document has been completely built
+    bool done() const noexcept { return _done; }
+
+    /// The built data. Only meaningful once `done()`.
+    const Data& result() const noexcept { return _result; }
+
+    /// Build whatever remains of the document without a budget, and take the result
+    Data finish() {
+        step(build_budget{});
+        return std::move(_result);
+    }
+};
+
+}  // namespace json5
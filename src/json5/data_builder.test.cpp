@@ -0,0 +1,57 @@
+#include <json5/data_builder.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+TEST_CASE("Build data in steps") {
+    auto str = GENERATE(as<std::string>{},
+                        "null",
+                        "'string'",
+                        "[]",
+                        "[1, [2, [3, []]], {}]",
+                        "{a: 1, b: [true, false], c: {d: 'e', 'f\\n': null}}",
+                        "{a: 1, a: 2}");
+    auto n_events = GENERATE(1u, 2u, 5u, 1000u);
+    CAPTURE(str, n_events);
+
+    json5::data_builder builder{str};
+    std::size_t         steps = 0;
+    for (;;) {
+        auto prog = builder.step(n_events);
+        CHECK(prog.events <= n_events);
+        CHECK(prog.offset <= prog.size);
+        ++steps;
+        if (prog.done) {
+            CHECK(prog.fraction() == 1.0);
+            break;
+        }
+        REQUIRE(steps < 1000);
+    }
+    CHECK(builder.done());
+    CHECK(builder.result() == json5::parse_data(str));
+}
+
+TEST_CASE("Build data with a byte budget") {
+    std::string str = "[";
+    for (int i = 0; i < 1000; ++i) {
+        str += "{id: " + std::to_string(i) + ", name: 'item'},";
+    }
+    str += "]";
+
+    json5::data_builder builder{str};
+    std::size_t         steps = 0;
+    while (!builder.step(json5::build_budget{.bytes = 512}).done) {
+        ++steps;
+    }
+    CHECK(steps > str.size() / 1024);
+    CHECK(builder.finish() == json5::parse_data(str));
+}
+
+TEST_CASE("Build data errors") {
+    auto str = GENERATE(as<std::string>{}, "[1, 2", "{a 1}", "[1] 2", "");
+    CAPTURE(str);
+    json5::data_builder builder{str};
+    CHECK_THROWS_AS(builder.finish(), json5::parse_error);
+    CHECK(builder.done());
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <json5/parse_data.hpp>
+
+#include <optional>
+#include <string_view>
+
+namespace json5 {
+
+struct document_end_sentinel {};
+
+/**
+ * Reads a sequence of concatenated top-level JSON5 values from a single buffer, such as a
+ * log file or message spool. Values may be separated by whitespace and comments. A single
+ * parser is used for the entire buffer, and its limits apply to each value separately.
+ */
+template <typename Data = data>
+class basic_document_stream {
+public:
+    struct document {
+        /// The parsed value
+        Data value;
+        /// The offset of the value within the input buffer
+        std::size_t offset = 0;
+        /// The source text of the value
+        std::string_view source;
+    };
+
+private:
+    std::string_view _buf;
+    parser           _p;
+    bool             _done = false;
+
+public:
+    explicit basic_document_stream(std::string_view buf, parse_options opts)
+        : _buf(buf)
+        , _p(buf, opts) {}
+
+    explicit basic_document_stream(std::string_view buf)
+        : basic_document_stream(buf, parse_options{}) {}
+
+    /**
+     * Parse the next value from the input. Returns an empty optional once the input is
+     * exhausted. Throws `parse_error` on invalid input.
+     */
+    std::optional<document> next() {
+        if (_done) {
+            return std::nullopt;
+        }
+        _p.begin_document();
+        auto ev = _p.next();
+        if (ev.kind == ev.eof) {
+            _done = true;
+            return std::nullopt;
+        }
+        const auto begin = static_cast<std::size_t>(ev.token.spelling.data() - _buf.data());
+        auto       value = detail::parse_inner<Data>(_p, ev);
+        const auto end   = _p.offset();
+        return document{std::move(value), begin, _buf.substr(begin, end - begin)};
+    }
+
+    bool done() const noexcept { return _done; }
+
+    class iterator {
+        basic_document_stream*  _s;
+        std::optional<document> _current;
+
+    public:
+        explicit iterator(basic_document_stream& s)
+            : _s(&s) {}
+
+        iterator& operator++() {
+            _current = _s->next();
+            return *this;
+        }
+
+        friend bool operator!=(const iterator& left, document_end_sentinel) noexcept {
+            return left._current.has_value();
+        }
+        friend bool operator!=(document_end_sentinel, const iterator& right) noexcept {
+            return right._current.has_value();
+        }
+        friend bool operator==(const iterator& left, document_end_sentinel s) noexcept {
+            return !(left != s);
+        }
+        friend bool operator==(document_end_sentinel s, const iterator& right) noexcept {
+            return !(s != right);
+        }
+
+        document* operator->() noexcept { return &*_current; }
+        document& operator*() noexcept { return *_current; }
+    };
+
+    iterator begin() {
+        auto it = iterator(*this);
+        ++it;
+        return it;
+    }
+    document_end_sentinel end() const noexcept { return {}; }
+};
+
+using document_stream = basic_document_stream<data>;
+
+}  // namespace json5
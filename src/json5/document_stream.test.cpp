@@ -0,0 +1,77 @@
+#include <json5/document_stream.hpp>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Read concatenated documents") {
+    std::string_view input = "{id: 1}\n// A comment\n{id: 2}[3, 4] 'five'  /* end */ ";
+
+    json5::document_stream docs{input};
+
+    auto doc = docs.next();
+    REQUIRE(doc);
+    CHECK(doc->value == json5::data::object_type({{"id", 1}}));
+    CHECK(doc->offset == 0);
+    CHECK(doc->source == "{id: 1}");
+
+    doc = docs.next();
+    REQUIRE(doc);
+    CHECK(doc->value == json5::data::object_type({{"id", 2}}));
+    CHECK(doc->source == "{id: 2}");
+    CHECK(doc->offset == 21);
+
+    doc = docs.next();
+    REQUIRE(doc);
+    CHECK(doc->source == "[3, 4]");
+
+    doc = docs.next();
+    REQUIRE(doc);
+    CHECK(doc->value == "five");
+    CHECK(doc->source == "'five'");
+
+    CHECK_FALSE(docs.next());
+    CHECK(docs.done());
+    CHECK_FALSE(docs.next());
+}
+
+TEST_CASE("Iterate concatenated documents") {
+    json5::document_stream docs{"1 2 3"};
+
+    int expect = 1;
+    for (auto& doc : docs) {
+        CHECK(doc.value == expect);
+        ++expect;
+    }
+    CHECK(expect == 4);
+
+    json5::document_stream empty{"  // Nothing here "};
+    CHECK(empty.begin() == empty.end());
+}
+
+TEST_CASE("Errors in concatenated documents") {
+    json5::document_stream docs{"{id: 1} {id: }"};
+    CHECK(docs.next());
+    CHECK_THROWS_AS(docs.next(), json5::parse_error);
+}
+
+TEST_CASE("Limits apply to each concatenated document") {
+    json5::parse_options opts;
+    opts.limits.max_nodes = 2;
+    json5::document_stream docs{"1 [2] 3", opts};
+    CHECK(docs.next());
+    CHECK(docs.next());
+    CHECK(docs.next());
+    CHECK_FALSE(docs.next());
+
+    opts.limits           = {};
+    opts.limits.max_bytes = 6;
+    json5::document_stream sized{"1   \n  [2, 3] 'four'  [5, 66]", opts};
+    CHECK(sized.next());
+    CHECK(sized.next());
+    CHECK(sized.next());
+    try {
+        sized.next();
+        FAIL("Expected a parse_error");
+    } catch (const json5::parse_error& e) {
+        CHECK_THAT(e.what(), Catch::Contains("Input exceeds the size limit"));
+    }
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <json5/parse.hpp>
+#include <json5/unicode.hpp>
+
+/**
+ * Coroutine support requires compiler support for C++20 coroutines. Without it, this
+ * header provides nothing.
+ */
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace json5 {
+
+/**
+ * An asynchronous generator of parse events.
+ *
+ * The consumer obtains each event with `co_await gen.next()`, which produces an empty
+ * optional once the generator has finished. The spelling of an event's token is only
+ * valid until the next call to `next()`.
+ */
+class event_generator {
+public:
+    struct promise_type;
+
+private:
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    handle_type _coro;
+
+    /// Transfers control from the generator back to the coroutine awaiting an event
+    struct to_consumer {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(handle_type h) const noexcept {
+            return h.promise().consumer;
+        }
+        void await_resume() const noexcept {}
+    };
+
+public:
+    struct promise_type {
+        std::optional<parse_event> current;
+        std::coroutine_handle<>    consumer;
+        std::exception_ptr         error;
+
+        event_generator get_return_object() noexcept {
+            return event_generator(handle_type::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        to_consumer         final_suspend() const noexcept { return {}; }
+
+        to_consumer yield_value(parse_event ev) noexcept {
+            current = std::move(ev);
+            return {};
+        }
+
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+    };
+
+    class next_awaiter {
+        handle_type _coro;
+
+    public:
+        explicit next_awaiter(handle_type h) noexcept
+            : _coro(h) {}
+
+        bool await_ready() const noexcept { return !_coro || _coro.done(); }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) noexcept {
+            _coro.promise().consumer = consumer;
+            _coro.promise().current.reset();
+            return _coro;
+        }
+
+        std::optional<parse_event> await_resume() {
+            if (!_coro || _coro.done()) {
+                if (_coro && _coro.promise().error) {
+                    std::rethrow_exception(std::exchange(_coro.promise().error, nullptr));
+                }
+                return std::nullopt;
+            }
+            return std::move(_coro.promise().current);
+        }
+    };
+
+    explicit event_generator(handle_type h) noexcept
+        : _coro(h) {}
+
+    event_generator(event_generator&& other) noexcept
+        : _coro(std::exchange(other._coro, nullptr)) {}
+
+    event_generator& operator=(event_generator&& other) noexcept {
+        std::swap(_coro, other._coro);
+        return *this;
+    }
+
+    ~event_generator() {
+        if (_coro) {
+            _coro.destroy();
+        }
+    }
+
+    /// Obtain an awaitable that produces the next event, or nothing if the generator is done
+    next_awaiter next() noexcept { return next_awaiter(_coro); }
+};
+
+/**
+ * Parse events from an asynchronous byte source.
+ *
+ * The source must outlive the generator, and must provide a `read_some()` member function
+ * returning an awaitable. The result of that awaitable must be convertible to
+ * `std::string_view`, and an empty result indicates the end of the input. The bytes are
+ * copied before `read_some()` is called again.
+ *
+ * The event stream finishes after an `eof` or `invalid` event. The input preceding the most
+ * recent token is dropped once it makes up half of the buffer, so memory use is bounded by
+ * twice the size of the largest token and the chunks produced by the source. The
+ * `max_bytes` limit of the options applies to all of the bytes read from the source.
+ */
+template <typename Source>
+event_generator parse_events_async(Source& source, parse_options opts) {
+    std::vector<char> buf;
+    parser            p{std::string_view(), opts};
+    bool              exhausted = false;
+
+    while (true) {
+        if (exhausted) {
+            auto ev = p.next();
+            co_yield ev;
+            if (ev.kind == parse_event::eof || ev.kind == parse_event::invalid) {
+                co_return;
+            }
+            continue;
+        }
+
+        // A token that ends within a byte of the end of the buffer might continue into the
+        // input that we have not yet seen. (The tokenizer looks one byte past a trailing `.`
+        // or `/`.) So might one near a character whose UTF-8 sequence is cut off by the end
+        // of the buffer. Only parse the next event once we have more input than that.
+        if (buf.size() - p.next_event_end() >= 2
+            && !detail::ends_in_partial_utf8(buf.data(), buf.data() + buf.size())) {
+            auto ev = p.next();
+            co_yield ev;
+            if (ev.kind == parse_event::eof || ev.kind == parse_event::invalid) {
+                co_return;
+            }
+            continue;
+        }
+
+        std::string_view chunk = co_await source.read_some();
+        if (chunk.empty()) {
+            exhausted = true;
+            continue;
+        }
+
+        // Drop the input that has been parsed once it is at least half of the buffer, so that
+        // the input of a long token isn't copied again for every chunk. Then append the chunk.
+        std::size_t n_discarded = p.offset();
+        if (n_discarded >= buf.size() - n_discarded) {
+            buf.erase(buf.begin(),
+                      buf.begin() + static_cast<std::vector<char>::difference_type>(n_discarded));
+        } else {
+            n_discarded = 0;
+        }
+        buf.insert(buf.end(), chunk.begin(), chunk.end());
+        // Rebasing also lets the scan for the end of the next event continue where it stopped
+        p.rebase(std::string_view(buf.data(), buf.size()), n_discarded);
+    }
+}
+
+template <typename Source>
+event_generator parse_events_async(Source& source) {
+    return parse_events_async(source, parse_options{});
+}
+
+}  // namespace json5
+
+#endif
@@ -0,0 +1,184 @@
+#include <json5/event_generator.hpp>
+
+#include <catch2/catch.hpp>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// A coroutine that runs eagerly and is never awaited
+struct detached {
+    struct promise_type {
+        detached            get_return_object() noexcept { return {}; }
+        std::suspend_never  initial_suspend() noexcept { return {}; }
+        std::suspend_never  final_suspend() noexcept { return {}; }
+        void                return_void() noexcept {}
+        void                unhandled_exception() { throw; }
+    };
+};
+
+/**
+ * A byte source that hands out its input in fixed-size chunks. Each read suspends the
+ * reader until `pump()` is called, as if waiting on an event loop.
+ */
+struct chunked_source {
+    std::string_view        input;
+    std::size_t             chunk_size;
+    std::coroutine_handle<> waiting;
+
+    struct read_awaiter {
+        chunked_source& src;
+        bool            await_ready() const noexcept { return false; }
+        void            await_suspend(std::coroutine_handle<> h) noexcept { src.waiting = h; }
+        std::string_view await_resume() noexcept {
+            auto chunk = src.input.substr(0, src.chunk_size);
+            src.input.remove_prefix(chunk.size());
+            return chunk;
+        }
+    };
+
+    read_awaiter read_some() noexcept { return {*this}; }
+
+    /// Resume a pending read. Returns `false` if nothing was waiting.
+    bool pump() {
+        if (!waiting) {
+            return false;
+        }
+        std::exchange(waiting, nullptr).resume();
+        return true;
+    }
+};
+
+struct seen_event {
+    json5::parse_event::kind_t kind;
+    std::string                spelling;
+
+    friend bool operator==(const seen_event& l, const seen_event& r) {
+        return l.kind == r.kind && l.spelling == r.spelling;
+    }
+};
+
+detached collect(json5::event_generator& gen, std::vector<seen_event>& out, bool& done) {
+    while (auto ev = co_await gen.next()) {
+        out.push_back({ev->kind, std::string(ev->token.spelling)});
+    }
+    done = true;
+}
+
+std::vector<seen_event> parse_in_chunks(std::string_view     input,
+                                        std::size_t          chunk_size,
+                                        json5::parse_options opts = {}) {
+    chunked_source          src{input, chunk_size, nullptr};
+    auto                    gen  = json5::parse_events_async(src, opts);
+    bool                    done = false;
+    std::vector<seen_event> events;
+    collect(gen, events, done);
+    while (src.pump()) {
+    }
+    CHECK(done);
+    return events;
+}
+
+}  // namespace
+
+using pek = json5::parse_event::kind_t;
+
+TEST_CASE("Parse events from an asynchronous source") {
+    std::string_view input = "{foo: [12.5, 'string', true], /* c */ bar: null, baz: 1.25}";
+
+    std::vector<seen_event> expected = {
+        {pek::object_begin, "{"},
+        {pek::object_key, "foo"},
+        {pek::array_begin, "["},
+        {pek::number_literal, "12.5"},
+        {pek::string_literal, "'string'"},
+        {pek::boolean_literal, "true"},
+        {pek::array_end, "]"},
+        {pek::object_key, "bar"},
+        {pek::null_literal, "null"},
+        {pek::object_key, "baz"},
+        {pek::number_literal, "1.25"},
+        {pek::object_end, "}"},
+        {pek::eof, ""},
+    };
+
+    // Every chunk size must produce the same events
+    for (std::size_t chunk_size = 1; chunk_size <= input.size(); ++chunk_size) {
+        INFO("Chunk size: " << chunk_size);
+        CHECK(parse_in_chunks(input, chunk_size) == expected);
+    }
+}
+
+TEST_CASE("Parse long tokens from an asynchronous source") {
+    // Each token spans many chunks
+    const std::string str     = "'" + std::string(200, 'a') + "\\'" + std::string(200, 'b') + "'";
+    const std::string comment = "/* " + std::string(300, '*') + " */";
+    const std::string number  = std::string(100, '1') + "." + std::string(100, '2');
+    const std::string input   = "[" + str + ", " + comment + number + "]";
+
+    std::vector<seen_event> expected = {
+        {pek::array_begin, "["},
+        {pek::string_literal, str},
+        {pek::number_literal, number},
+        {pek::array_end, "]"},
+        {pek::eof, ""},
+    };
+    for (std::size_t chunk_size : std::initializer_list<std::size_t>{1, 3, 7, 16, 64}) {
+        INFO("Chunk size: " << chunk_size);
+        CHECK(parse_in_chunks(input, chunk_size) == expected);
+    }
+}
+
+TEST_CASE("Asynchronous parse errors") {
+    auto events = parse_in_chunks("[1, 2 3]", 2);
+    REQUIRE_FALSE(events.empty());
+    CHECK(events.back().kind == pek::invalid);
+    CHECK(events.back().spelling == "3");
+
+    events = parse_in_chunks("[1, 2", 3);
+    REQUIRE_FALSE(events.empty());
+    CHECK(events.back().kind == pek::invalid);
+}
+
+TEST_CASE("Asynchronous parsing applies the size limit to the whole stream") {
+    json5::parse_options opts;
+    opts.limits.max_bytes = 16;
+
+    // Less than a chunk is ever buffered, but the input is still too large
+    auto events = parse_in_chunks("[1, 2, 3, 4, 5, 6, 7, 8, 9]", 4, opts);
+    REQUIRE_FALSE(events.empty());
+    CHECK(events.back().kind == pek::invalid);
+
+    events = parse_in_chunks("[1, 2, 3, 4, 5]", 4, opts);
+    REQUIRE_FALSE(events.empty());
+    CHECK(events.back().kind == pek::eof);
+}
+
+TEST_CASE("Asynchronous parsing of non-ASCII input") {
+    // Chunk boundaries fall within the UTF-8 sequences of strings and identifiers
+    std::string_view input = "{a\u4e2d: ['\xf0\x9f\x98\x80', '\xc3\xa9'], \xc3\xa9t\xc3\xa9: 1}";
+
+    std::vector<seen_event> expected = {
+        {pek::object_begin, "{"},
+        {pek::object_key, "a\u4e2d"},
+        {pek::array_begin, "["},
+        {pek::string_literal, "'\xf0\x9f\x98\x80'"},
+        {pek::string_literal, "'\xc3\xa9'"},
+        {pek::array_end, "]"},
+        {pek::object_key, "\xc3\xa9t\xc3\xa9"},
+        {pek::number_literal, "1"},
+        {pek::object_end, "}"},
+        {pek::eof, ""},
+    };
+
+    for (std::size_t chunk_size = 1; chunk_size <= input.size(); ++chunk_size) {
+        INFO("Chunk size: " << chunk_size);
+        CHECK(parse_in_chunks(input, chunk_size) == expected);
+    }
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "./file_cache.hpp"
+
+#include <fstream>
+#include <sstream>
+
+using namespace json5;
+
+namespace {
+
+std::string read_file(const std::filesystem::path& filepath) {
+    std::ifstream infile{filepath, std::ios::binary};
+    if (!infile) {
+        throw std::filesystem::filesystem_error("Failed to open file for reading",
+                                                filepath,
+                                                std::make_error_code(std::errc::io_error));
+    }
+    std::stringstream strm;
+    strm << infile.rdbuf();
+    return std::move(strm).str();
+}
+
+}  // namespace
+
+file_cache::file_identity file_cache::_identity_of(const std::filesystem::path& filepath) {
+    file_identity ret;
+    ret.size  = std::filesystem::file_size(filepath);
+    ret.mtime = std::filesystem::last_write_time(filepath);
+    return ret;
+}
+
+file_cache::data_ptr file_cache::get(const std::filesystem::path& filepath) {
+    // Stat the file before taking the lock, so that a slow filesystem doesn't block lookups of
+    // other files.
+    const auto identity = _identity_of(filepath);
+
+    std::promise<data_ptr>       promise;
+    std::shared_future<data_ptr> result = promise.get_future().share();
+    {
+        std::unique_lock lk{_mtx};
+        auto             found = _entries.find(filepath);
+        if (found != _entries.end() && found->second.identity == identity) {
+            // Either already parsed, or another thread is parsing it right now
+            result = found->second.result;
+            lk.unlock();
+            return result.get();
+        }
+        _entries.insert_or_assign(filepath, entry{identity, result});
+    }
+
+    // We are the thread responsible for parsing this file.
+    try {
+        auto content = read_file(filepath);
+        promise.set_value(std::make_shared<const data>(parse_data(content, _opts)));
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+    return result.get();
+}
+
+void file_cache::erase(const std::filesystem::path& filepath) {
+    std::unique_lock lk{_mtx};
+    _entries.erase(filepath);
+}
+
+void file_cache::clear() {
+    std::unique_lock lk{_mtx};
+    _entries.clear();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <json5/data.hpp>
+#include <json5/parse_data.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace json5 {
+
+/**
+ * A cache of parsed JSON5 files, keyed by path.
+ *
+ * Each `get()` performs a `stat` of the file and compares its identity (size and
+ * last-write-time) with that of the cached parse. The file is only re-read and re-parsed
+ * if its identity has changed. Concurrent `get()`s of the same file while a parse is in
+ * progress will wait on that parse rather than starting their own.
+ *
+ * A file that fails to parse has its error cached as well: `get()` will re-throw the same
+ * `parse_error` until the file is modified.
+ */
+class file_cache {
+public:
+    using data_ptr = std::shared_ptr<const data>;
+
+private:
+    struct file_identity {
+        std::uintmax_t                  size = 0;
+        std::filesystem::file_time_type mtime;
+
+        friend bool operator==(const file_identity& lhs, const file_identity& rhs) noexcept {
+            return lhs.size == rhs.size && lhs.mtime == rhs.mtime;
+        }
+    };
+
+    struct entry {
+        file_identity                identity;
+        std::shared_future<data_ptr> result;
+    };
+
+    parse_options                          _opts;
+    std::mutex                             _mtx;
+    std::map<std::filesystem::path, entry> _entries;
+
+    static file_identity _identity_of(const std::filesystem::path&);
+
+public:
+    explicit file_cache(parse_options opts)
+        : _opts(opts) {}
+
+    file_cache()
+        : file_cache(parse_options{}) {}
+
+    /**
+     * Obtain the parsed data of the file at the given path, parsing it only if it is not
+     * cached or has changed since it was last parsed.
+     */
+    data_ptr get(const std::filesystem::path& filepath);
+
+    /// Drop the cached data of the given file, if present
+    void erase(const std::filesystem::path& filepath);
+    /// Drop all cached data
+    void clear();
+};
+
+}  // namespace json5
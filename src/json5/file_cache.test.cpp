@@ -0,0 +1,59 @@
+#include <json5/file_cache.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <fstream>
+#include <string>
+
+#if defined(_WIN32)
+#include <process.h>
+#define JSON5_TEST_GETPID _getpid
+#else
+#include <unistd.h>
+#define JSON5_TEST_GETPID getpid
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/// A path in the temporary directory that is unique to the named test and this process
+fs::path temp_file_path(std::string_view test_name) {
+    return fs::temp_directory_path()
+        / ("json5-" + std::string(test_name) + "-" + std::to_string(JSON5_TEST_GETPID())
+           + ".json5");
+}
+
+void write_file(const fs::path& filepath, std::string_view content) {
+    std::ofstream out{filepath, std::ios::binary};
+    out << content;
+}
+
+}  // namespace
+
+TEST_CASE("Cache parsed files") {
+    auto filepath = temp_file_path("file-cache-test");
+    write_file(filepath, "{foo: 'bar'}");
+
+    json5::file_cache cache;
+    auto              first = cache.get(filepath);
+    CHECK(*first == json5::data::object_type({{"foo", "bar"}}));
+
+    // An unchanged file gives back the same data
+    auto second = cache.get(filepath);
+    CHECK(first == second);
+
+    // A modified file is re-parsed
+    write_file(filepath, "{foo: 'bar', baz: 2}");
+    auto third = cache.get(filepath);
+    CHECK(third != first);
+    CHECK(*third == json5::data::object_type({{"foo", "bar"}, {"baz", 2}}));
+
+    // Errors are propagated
+    write_file(filepath, "{foo: }");
+    CHECK_THROWS_AS(cache.get(filepath), json5::parse_error);
+
+    cache.erase(filepath);
+    fs::remove(filepath);
+    CHECK_THROWS_AS(cache.get(filepath), fs::filesystem_error);
+}
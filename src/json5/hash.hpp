@@ -0,0 +1,124 @@
+#pragma once
+
+#include <json5/data.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <utility>
+
+namespace json5 {
+
+namespace detail {
+
+inline std::size_t hash_mix(std::size_t seed, std::size_t value) noexcept {
+    // The 64-bit finalizer of MurmurHash3, applied to the combination
+    std::uint64_t h = seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+}
+
+inline std::size_t hash_number(double d) noexcept {
+    if (d == 0) {
+        // Positive and negative zero compare equal
+        d = 0;
+    } else if (std::isnan(d)) {
+        return 0x7ff8;
+    }
+    return std::hash<double>{}(d);
+}
+
+/// Distinct seeds for each kind, so that e.g. `[]` and `{}` do not collide
+enum hash_seed : std::size_t {
+    hash_null = 0x6e756c6c,
+    hash_boolean,
+    hash_number_seed,
+    hash_string,
+    hash_array,
+    hash_object,
+};
+
+}  // namespace detail
+
+/**
+ * Compute a hash of the given data that is consistent with `operator==`: Equal data has
+ * equal hashes. The hash of an object does not depend on the order of its members, so it
+ * may be used with object types that are not ordered.
+ */
+template <typename Traits>
+std::size_t structural_hash(const basic_data<Traits>& dat) {
+    using detail::hash_mix;
+    if (dat.is_null()) {
+        return detail::hash_null;
+    } else if (dat.is_boolean()) {
+        return hash_mix(detail::hash_boolean, dat.as_boolean() ? 1 : 0);
+    } else if (dat.is_number()) {
+        return hash_mix(detail::hash_number_seed,
+                        detail::hash_number(static_cast<double>(dat.as_number())));
+    } else if (dat.is_string()) {
+        const auto& str = dat.as_string();
+        return hash_mix(detail::hash_string,
+                        std::hash<std::string_view>{}({str.data(), str.size()}));
+    } else if (dat.is_array()) {
+        std::size_t h = detail::hash_array;
+        for (const auto& elem : dat.as_array()) {
+            h = hash_mix(h, structural_hash(elem));
+        }
+        return h;
+    } else {
+        // Members are combined with a sum, which does not depend on their order
+        std::size_t sum = 0;
+        for (const auto& [key, value] : dat.as_object()) {
+            const auto key_hash = std::hash<std::string_view>{}({key.data(), key.size()});
+            sum += hash_mix(key_hash, structural_hash(value));
+        }
+        return hash_mix(detail::hash_object, sum);
+    }
+}
+
+/**
+ * An immutable data value together with its structural hash, computed once on
+ * construction. Comparison of `hashed` values compares their hashes before comparing
+ * their contents, so unequal values are usually told apart without a traversal.
+ */
+template <typename Data>
+class hashed {
+    Data        _value;
+    std::size_t _hash;
+
+public:
+    hashed(Data value)
+        : _value(std::move(value))
+        , _hash(structural_hash(_value)) {}
+
+    const Data& value() const noexcept { return _value; }
+    const Data& operator*() const noexcept { return _value; }
+    const Data* operator->() const noexcept { return &_value; }
+
+    std::size_t hash() const noexcept { return _hash; }
+
+    friend bool operator==(const hashed& lhs, const hashed& rhs) {
+        return lhs._hash == rhs._hash && lhs._value == rhs._value;
+    }
+    friend bool operator!=(const hashed& lhs, const hashed& rhs) { return !(lhs == rhs); }
+};
+
+}  // namespace json5
+
+template <typename Traits>
+struct std::hash<json5::basic_data<Traits>> {
+    std::size_t operator()(const json5::basic_data<Traits>& dat) const {
+        return json5::structural_hash(dat);
+    }
+};
+
+template <typename Data>
+struct std::hash<json5::hashed<Data>> {
+    std::size_t operator()(const json5::hashed<Data>& h) const noexcept { return h.hash(); }
+};
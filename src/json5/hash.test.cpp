@@ -0,0 +1,37 @@
+#include <json5/hash.hpp>
+
+#include <json5/parse_data.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <unordered_set>
+
+TEST_CASE("Equal data has equal hashes") {
+    auto a = json5::parse_data("{b: [1, 'two', null, true], a: {c: 0}}");
+    auto b = json5::parse_data("{'a': {\"c\": -0}, b: [1.0, \"two\", null, true,],}");
+    REQUIRE(a == b);
+    CHECK(json5::structural_hash(a) == json5::structural_hash(b));
+    CHECK(std::hash<json5::data>{}(a) == json5::structural_hash(a));
+}
+
+TEST_CASE("Different data has different hashes") {
+    auto hash = [](std::string_view str) { return json5::structural_hash(json5::parse_data(str)); };
+    CHECK(hash("[]") != hash("{}"));
+    CHECK(hash("[1, 2]") != hash("[2, 1]"));
+    CHECK(hash("{a: 1, b: 2}") != hash("{a: 2, b: 1}"));
+    CHECK(hash("'1'") != hash("1"));
+    CHECK(hash("[[]]") != hash("[]"));
+    CHECK(hash("true") != hash("false"));
+}
+
+TEST_CASE("Deduplicate with hashed data") {
+    std::unordered_set<json5::hashed<json5::data>> seen;
+    for (auto str : {"{a: [1, 2]}", "{'a': [1, 2,]}", "{a: [1, 3]}", "null", "null"}) {
+        seen.emplace(json5::parse_data(str));
+    }
+    CHECK(seen.size() == 3);
+
+    json5::hashed<json5::data> h = json5::parse_data("{x: 'y'}");
+    CHECK(h->is_object());
+    CHECK(h.hash() == json5::structural_hash(*h));
+}
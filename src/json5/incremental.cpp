@@ -0,0 +1,74 @@
+#include "./incremental.hpp"
+
+#include <algorithm>
+
+using namespace json5;
+
+std::optional<std::vector<std::size_t>> detail::find_enclosing_span(const span_node& root,
+                                                                     std::size_t      begin,
+                                                                     std::size_t      end) {
+    if (begin < root.offset || end > root.offset + root.length) {
+        return std::nullopt;
+    }
+    std::vector<std::size_t> path;
+    const span_node*         node = &root;
+    std::size_t              base = root.offset;
+    while (!node->children.empty()) {
+        // The last child that begins at or before the edit
+        const auto& children = node->children;
+        auto        it       = std::upper_bound(children.begin(),
+                                   children.end(),
+                                   begin - base,
+                                   [](std::size_t off, const span_node& child) {
+                                       return off < child.offset;
+                                   });
+        if (it == children.begin()) {
+            break;
+        }
+        --it;
+        const auto child_begin = base + it->offset;
+        if (end > child_begin + it->length) {
+            break;
+        }
+        path.push_back(static_cast<std::size_t>(it - children.begin()));
+        node = &*it;
+        base = child_begin;
+    }
+    return path;
+}
+
+std::size_t detail::span_offset(const span_node& root, const std::vector<std::size_t>& path) {
+    std::size_t      ret  = root.offset;
+    const span_node* node = &root;
+    for (auto idx : path) {
+        node = &node->children[idx];
+        ret += node->offset;
+    }
+    return ret;
+}
+
+detail::span_node& detail::span_at(span_node& root, const std::vector<std::size_t>& path) {
+    span_node* node = &root;
+    for (auto idx : path) {
+        node = &node->children[idx];
+    }
+    return *node;
+}
+
+void detail::shift_spans(span_node& root, const std::vector<std::size_t>& path,
+                         std::ptrdiff_t delta) {
+    const auto shift = [delta](std::size_t& n) {
+        n = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(n) + delta);
+    };
+    span_node* node = &root;
+    for (auto idx : path) {
+        shift(node->length);
+        for (auto it = node->children.begin() + static_cast<std::ptrdiff_t>(idx) + 1;
+             it != node->children.end();
+             ++it) {
+            shift(it->offset);
+            shift(it->key_offset);
+        }
+        node = &node->children[idx];
+    }
+}
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <json5/data.hpp>
+#include <json5/parse.hpp>
+#include <json5/parse_data.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json5 {
+
+namespace detail {
+
+/**
+ * The extent of a value in the source text. Offsets are relative to the start of the
+ * parent value (or the start of the text, for the root), so that an edit only needs to
+ * shift the siblings that follow it, and not every node after it.
+ */
+struct span_node {
+    /// The offset of the value
+    std::size_t offset = 0;
+    std::size_t length = 0;
+    /// For an object member, the offset of its key
+    std::size_t key_offset = 0;
+    std::size_t key_length = 0;
+    /// Whether this is an object member
+    bool is_member = false;
+    /// Whether this member is hidden by an earlier member with the same key
+    bool shadowed = false;
+    /// The elements or members, in source order
+    std::vector<span_node> children;
+};
+
+/**
+ * Find the deepest node whose value contains the bytes `[begin, end)` of the text. The
+ * bounds are inclusive: A node "contains" an insertion at either of its ends. Returns the
+ * child indices from the root to that node, or an empty optional if not even the root
+ * contains it.
+ */
+std::optional<std::vector<std::size_t>>
+find_enclosing_span(const span_node& root, std::size_t begin, std::size_t end);
+
+/// Obtain the absolute offset of the node at the given path
+std::size_t span_offset(const span_node& root, const std::vector<std::size_t>& path);
+
+/// Obtain the node at the given path
+span_node& span_at(span_node& root, const std::vector<std::size_t>& path);
+
+/**
+ * Account for a change in the length of the node at `path` by `delta` bytes: Grow each of
+ * its ancestors, and shift the siblings that follow it and each of its ancestors. The node
+ * itself is not changed.
+ */
+void shift_spans(span_node& root, const std::vector<std::size_t>& path, std::ptrdiff_t delta);
+
+/**
+ * Parse the value that begins with `ev`, recording its span into `out`. `base` is the
+ * start of the text, and `parent_offset` is the offset of the parent value within it.
+ */
+template <typename Data>
+Data parse_spanned(parser&            p,
+                   const parse_event& ev,
+                   const char*        base,
+                   std::size_t        parent_offset,
+                   span_node&         out) {
+    using object_type = typename Data::mapping_type;
+    using key_type    = typename object_type::key_type;
+    using mapped_type = typename object_type::mapped_type;
+    using pek         = parse_event::kind_t;
+
+    if (ev.kind == pek::invalid || ev.kind == pek::eof) {
+        // Throws
+        return parse_inner<Data>(p, ev);
+    }
+
+    const auto start = static_cast<std::size_t>(ev.token.spelling.data() - base);
+    out.offset       = start - parent_offset;
+    const auto close = [&](const parse_event& end_ev) {
+        out.length = static_cast<std::size_t>(end_ev.token.spelling.data() - base) + 1 - start;
+    };
+
+    switch (ev.kind) {
+    case pek::array_begin: {
+        typename Data::array_type arr;
+        auto                      elem_ev = p.next();
+        for (; elem_ev.kind != pek::array_end; elem_ev = p.next()) {
+            charge_allocation(p, sizeof(Data), elem_ev.token);
+            auto& child = out.children.emplace_back();
+            arr.push_back(parse_spanned<Data>(p, elem_ev, base, start, child));
+        }
+        close(elem_ev);
+        return arr;
+    }
+    case pek::object_begin: {
+        object_type obj;
+        auto        key_ev = p.next();
+        for (; key_ev.kind != pek::object_end; key_ev = p.next()) {
+            if (key_ev.kind != pek::object_key) {
+                throw_error(p.error_message(), key_ev.token);
+            }
+            const auto& key_tok = key_ev.token;
+            auto        key     = realize_member_key<key_type>(
+                p, key_tok, sizeof(typename object_type::value_type));
+            auto& child      = out.children.emplace_back();
+            child.is_member  = true;
+            child.key_offset = static_cast<std::size_t>(key_tok.spelling.data() - base) - start;
+            child.key_length = key_tok.spelling.size();
+            auto value       = parse_spanned<Data>(p, p.next(), base, start, child);
+            child.shadowed
+                = !obj.emplace(std::move(key), static_cast<mapped_type>(std::move(value))).second;
+        }
+        close(key_ev);
+        return obj;
+    }
+    default:
+        out.length = ev.token.spelling.size();
+        return parse_inner<Data>(p, ev);
+    }
+}
+
+}  // namespace detail
+
+/**
+ * A parsed document that is kept up to date with edits to its text, for editors and
+ * language servers that re-parse on every change.
+ *
+ * The document records the span of every value in the text. After an edit, only the
+ * deepest value that encloses the edit is re-parsed, and its data replaces the old data in
+ * place. If that value no longer parses as a single value on its own, its parent is tried
+ * instead, and so on up to the root, at which point the entire text is parsed. The cost
+ * of an edit within a value is therefore proportional to the size of that value, plus the
+ * number of its following siblings and those of its ancestors.
+ *
+ * Parse limits apply to each re-parsed region separately.
+ */
+template <typename Data = data>
+class incremental_document {
+    std::string       _text;
+    parse_options     _opts;
+    Data              _value;
+    detail::span_node _root;
+    bool              _valid         = false;
+    std::size_t       _last_reparsed = 0;
+
+    void _parse_all() {
+        _valid         = false;
+        _last_reparsed = _text.size();
+        parser            p{_text, _opts};
+        detail::span_node root;
+        auto value  = detail::parse_spanned<Data>(p, p.next(), _text.data(), 0, root);
+        auto eof_ev = p.next();
+        if (eof_ev.kind != eof_ev.eof) {
+            detail::throw_error("Trailing characters in JSON data", eof_ev.token);
+        }
+        _value = std::move(value);
+        _root  = std::move(root);
+        _valid = true;
+    }
+
+    /**
+     * Find the data for the node at the given path. Returns `nullptr` if the node is a
+     * member that is hidden by an earlier one with the same key.
+     */
+    Data* _data_at(const std::vector<std::size_t>& path) {
+        using key_type          = typename Data::mapping_type::key_type;
+        Data*              cur  = &_value;
+        detail::span_node* node = &_root;
+        std::size_t        base = _root.offset;
+        for (auto idx : path) {
+            auto& child = node->children[idx];
+            if (cur->is_array()) {
+                cur = &cur->as_array()[idx];
+            } else {
+                if (child.shadowed) {
+                    return nullptr;
+                }
+                const auto spelling = std::string_view(_text).substr(base + child.key_offset,
+                                                                     child.key_length);
+                key_type   key;
+                if (spelling.front() == '"' || spelling.front() == '\'') {
+                    key = detail::realize_string<key_type>(
+                        token{spelling, 0, 0, token::string_literal});
+                } else {
+                    key = key_type(spelling);
+                }
+                cur = &cur->as_object().find(key)->second;
+            }
+            base += child.offset;
+            node = &child;
+        }
+        return cur;
+    }
+
+    /// Try to re-parse the node at `path` in place, which has changed in length by `delta`
+    bool _reparse(const std::vector<std::size_t>& path, std::ptrdiff_t delta) {
+        auto&      node   = detail::span_at(_root, path);
+        const auto offset = detail::span_offset(_root, path);
+        const auto length = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(node.length)
+                                                     + delta);
+        const auto region = std::string_view(_text).substr(offset, length);
+
+        detail::span_node fresh;
+        Data              value;
+        try {
+            parser p{region, _opts};
+            value       = detail::parse_spanned<Data>(p, p.next(), region.data(), 0, fresh);
+            auto eof_ev = p.next();
+            // The value must fill the region exactly. Leading or trailing trivia could
+            // change how the surrounding text is tokenized.
+            if (eof_ev.kind != eof_ev.eof || fresh.offset != 0 || fresh.length != length) {
+                return false;
+            }
+        } catch (const std::exception&) {
+            return false;
+        }
+        _last_reparsed = length;
+
+        if (auto target = _data_at(path)) {
+            *target = std::move(value);
+        }
+        fresh.offset     = node.offset;
+        fresh.key_offset = node.key_offset;
+        fresh.key_length = node.key_length;
+        fresh.is_member  = node.is_member;
+        fresh.shadowed   = node.shadowed;
+        node             = std::move(fresh);
+        detail::shift_spans(_root, path, delta);
+        return true;
+    }
+
+public:
+    /// Parse the given text. Throws `parse_error` if it is invalid.
+    explicit incremental_document(std::string text, parse_options opts)
+        : _text(std::move(text))
+        , _opts(opts) {
+        _parse_all();
+    }
+
+    explicit incremental_document(std::string text)
+        : incremental_document(std::move(text), parse_options{}) {}
+
+    const std::string& text() const noexcept { return _text; }
+
+    /**
+     * The data of the document. If the text is currently invalid, this is the data of the
+     * last text that was valid.
+     */
+    const Data& value() const noexcept { return _value; }
+
+    /// Whether the current text is valid
+    bool valid() const noexcept { return _valid; }
+
+    /// The number of bytes of text that were parsed for the most recent edit
+    std::size_t last_reparsed_bytes() const noexcept { return _last_reparsed; }
+
+    /**
+     * Replace `removed` bytes of the text at `offset` with `inserted`, and update the data
+     * to match. Throws `std::out_of_range` if the range is not within the text. If the new
+     * text is invalid, throws as `parse_data` would. The text is still updated, and the next
+     * edit re-parses the entire text.
+     */
+    void edit(std::size_t offset, std::size_t removed, std::string_view inserted) {
+        if (offset > _text.size() || removed > _text.size() - offset) {
+            throw std::out_of_range("Edit range is outside of the document");
+        }
+        _text.replace(offset, removed, inserted);
+        if (_valid) {
+            const auto delta = static_cast<std::ptrdiff_t>(inserted.size())
+                - static_cast<std::ptrdiff_t>(removed);
+            if (auto path = detail::find_enclosing_span(_root, offset, offset + removed)) {
+                // Try the enclosing value, then each of its ancestors in turn
+                while (true) {
+                    if (_reparse(*path, delta)) {
+                        return;
+                    }
+                    if (path->empty()) {
+                        break;
+                    }
+                    path->pop_back();
+                }
+            }
+        }
+        _parse_all();
+    }
+};
+
+}  // namespace json5
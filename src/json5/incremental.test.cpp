@@ -0,0 +1,117 @@
+#include <json5/incremental.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <optional>
+#include <random>
+#include <string>
+
+namespace {
+
+std::optional<json5::data> try_parse(std::string_view str) {
+    try {
+        return json5::parse_data(str);
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Incremental edits re-parse the enclosing value") {
+    std::string text = "{name: 'config', list: [1, 22, 333], nested: {deep: {value: 'x'}}}";
+    json5::incremental_document doc{text};
+    CHECK(doc.last_reparsed_bytes() == text.size());
+
+    // Change `22` to `42`
+    doc.edit(text.find("22"), 1, "4");
+    CHECK(doc.value() == json5::parse_data(doc.text()));
+    CHECK(doc.last_reparsed_bytes() == 2);
+
+    // Append a digit to a number, at the end of its span
+    doc.edit(doc.text().find("333") + 3, 0, "4");
+    CHECK(doc.value().as_object().at("list").as_array()[2] == 3334);
+    CHECK(doc.last_reparsed_bytes() == 4);
+
+    // Add an element: The number alone does not parse, so the array is re-parsed
+    doc.edit(doc.text().find("3334") + 4, 0, ", 5");
+    CHECK(doc.value() == json5::parse_data(doc.text()));
+    CHECK(doc.last_reparsed_bytes() == std::string_view("[1, 42, 3334, 5]").size());
+
+    // A change deep within the document only touches the innermost value
+    doc.edit(doc.text().find("'x'") + 1, 1, "changed");
+    CHECK(doc.value().as_object().at("nested").as_object().at("deep").as_object().at("value")
+          == "changed");
+    CHECK(doc.last_reparsed_bytes() == std::string_view("'changed'").size());
+
+    // Rename a key: The object containing the member is re-parsed
+    doc.edit(doc.text().find("deep"), 4, "deeper");
+    CHECK(doc.value() == json5::parse_data(doc.text()));
+    CHECK(doc.value().as_object().at("nested").as_object().count("deeper") == 1);
+}
+
+TEST_CASE("Incremental edits through invalid text") {
+    json5::incremental_document doc{"[1, {a: 2}]"};
+    CHECK_THROWS_AS(doc.edit(4, 1, ""), json5::parse_error);
+    CHECK_FALSE(doc.valid());
+    CHECK(doc.text() == "[1, a: 2}]");
+    CHECK(doc.value() == json5::parse_data("[1, {a: 2}]"));
+
+    doc.edit(4, 0, "{");
+    CHECK(doc.valid());
+    CHECK(doc.value() == json5::parse_data("[1, {a: 2}]"));
+
+    CHECK_THROWS_AS(doc.edit(100, 0, "x"), std::out_of_range);
+}
+
+TEST_CASE("Incremental edits agree with a full parse") {
+    const std::string seed = R"({
+    name: 'the name', "other": "with \"escapes\"",
+    list: [1, -2.5, .5, +7, Infinity, null, true, false,],
+    /* block */ nested: {a: [], b: {}, c: [[{d: 'e'}]]},
+    dup: 1, dup: 2, // comment
+})";
+    const char   alphabet[] = "0123456789  \n.ax,[]{}:'\"/*";
+    std::mt19937 rng{4242};
+    int          n_partial = 0;
+
+    for (int round = 0; round < 20; ++round) {
+        json5::incremental_document doc{seed};
+        for (int n = 0; n < 50; ++n) {
+            const auto& text    = doc.text();
+            const auto  offset  = std::uniform_int_distribution<std::size_t>{0, text.size()}(rng);
+            const auto  max_rm  = std::min<std::size_t>(3, text.size() - offset);
+            const auto  removed = std::uniform_int_distribution<std::size_t>{0, max_rm}(rng);
+            std::string inserted;
+            const auto  n_ins = std::uniform_int_distribution<int>{0, 2}(rng);
+            for (int i = 0; i < n_ins; ++i) {
+                inserted.push_back(alphabet[std::uniform_int_distribution<std::size_t>{
+                    0, sizeof alphabet - 2}(rng)]);
+            }
+
+            const auto  old_text      = text;
+            std::string expected_text = text;
+            expected_text.replace(offset, removed, inserted);
+            const auto expected = try_parse(expected_text);
+            INFO("Text: " << expected_text);
+            if (expected) {
+                doc.edit(offset, removed, inserted);
+                CHECK(doc.valid());
+                CHECK(doc.value() == *expected);
+                if (doc.last_reparsed_bytes() < doc.text().size()) {
+                    ++n_partial;
+                }
+            } else {
+                CHECK_THROWS(doc.edit(offset, removed, inserted));
+                CHECK_FALSE(doc.valid());
+                CHECK(doc.text() == expected_text);
+                // Undo the edit, which makes the document valid again
+                doc.edit(offset, inserted.size(), old_text.substr(offset, removed));
+                CHECK(doc.valid());
+                CHECK(doc.value() == json5::parse_data(old_text));
+            }
+        }
+    }
+    // Most valid edits should not need the entire document to be re-parsed
+    CHECK(n_partial > 100);
+}
@@ -0,0 +1,392 @@
+#pragma once
+
+#include <json5/data.hpp>
+#include <json5/hash.hpp>
+#include <json5/parse_data.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace json5 {
+
+/**
+ * An immutable string whose storage is shared between copies. Equality compares the
+ * storage pointers before the contents.
+ */
+class shared_string {
+    std::shared_ptr<const std::string> _str;
+
+public:
+    shared_string() = default;
+    shared_string(std::string str)
+        : _str(std::make_shared<const std::string>(std::move(str))) {}
+    shared_string(std::string_view str)
+        : shared_string(std::string(str)) {}
+    shared_string(const char* str)
+        : shared_string(std::string(str)) {}
+
+    const std::string& str() const noexcept {
+        static const std::string empty;
+        return _str ? *_str : empty;
+    }
+
+    const char* data() const noexcept { return str().data(); }
+    std::size_t size() const noexcept { return str().size(); }
+    bool        empty() const noexcept { return size() == 0; }
+    const char* begin() const noexcept { return data(); }
+    const char* end() const noexcept { return data() + size(); }
+
+    operator std::string_view() const noexcept { return str(); }
+
+    /// Whether both strings refer to the same storage
+    bool shares_with(const shared_string& other) const noexcept { return _str == other._str; }
+
+    friend bool operator==(const shared_string& lhs, const shared_string& rhs) noexcept {
+        return lhs._str == rhs._str || lhs.str() == rhs.str();
+    }
+    friend bool operator!=(const shared_string& lhs, const shared_string& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+    friend bool operator<(const shared_string& lhs, const shared_string& rhs) noexcept {
+        return lhs.str() < rhs.str();
+    }
+    friend bool operator<=(const shared_string& lhs, const shared_string& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+    friend bool operator>(const shared_string& lhs, const shared_string& rhs) noexcept {
+        return rhs < lhs;
+    }
+    friend bool operator>=(const shared_string& lhs, const shared_string& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+};
+
+/**
+ * An array whose elements are shared between copies. Modifying an array that shares its
+ * elements with another copies them first, so a shared instance is never changed.
+ */
+template <typename T>
+class shared_array {
+    std::shared_ptr<std::vector<T>> _vec;
+
+    std::vector<T>& _unshare() {
+        if (!_vec) {
+            _vec = std::make_shared<std::vector<T>>();
+        } else if (_vec.use_count() > 1) {
+            _vec = std::make_shared<std::vector<T>>(*_vec);
+        }
+        return *_vec;
+    }
+
+public:
+    using value_type     = T;
+    using const_iterator = typename std::vector<T>::const_iterator;
+    using iterator       = const_iterator;
+
+    shared_array() = default;
+    explicit shared_array(std::vector<T> elems)
+        : _vec(std::make_shared<std::vector<T>>(std::move(elems))) {}
+
+    const std::vector<T>& elements() const noexcept {
+        static const std::vector<T> empty;
+        return _vec ? *_vec : empty;
+    }
+
+    std::size_t    size() const noexcept { return elements().size(); }
+    bool           empty() const noexcept { return elements().empty(); }
+    const_iterator begin() const noexcept { return elements().begin(); }
+    const_iterator end() const noexcept { return elements().end(); }
+    const T&       operator[](std::size_t idx) const noexcept { return elements()[idx]; }
+    const T&       at(std::size_t idx) const { return elements().at(idx); }
+
+    void reserve(std::size_t n) { _unshare().reserve(n); }
+    void push_back(T elem) { _unshare().push_back(std::move(elem)); }
+
+    /// Whether both arrays refer to the same elements
+    bool shares_with(const shared_array& other) const noexcept { return _vec == other._vec; }
+
+    friend bool operator==(const shared_array& lhs, const shared_array& rhs) {
+        return lhs._vec == rhs._vec || lhs.elements() == rhs.elements();
+    }
+    friend bool operator!=(const shared_array& lhs, const shared_array& rhs) {
+        return !(lhs == rhs);
+    }
+    friend bool operator<(const shared_array& lhs, const shared_array& rhs) {
+        return lhs.elements() < rhs.elements();
+    }
+    friend bool operator<=(const shared_array& lhs, const shared_array& rhs) {
+        return !(rhs < lhs);
+    }
+    friend bool operator>(const shared_array& lhs, const shared_array& rhs) { return rhs < lhs; }
+    friend bool operator>=(const shared_array& lhs, const shared_array& rhs) {
+        return !(lhs < rhs);
+    }
+};
+
+/**
+ * An ordered mapping whose members are shared between copies. As with `shared_array`,
+ * modifying a shared instance copies it first.
+ */
+template <typename Key, typename T>
+class shared_object {
+public:
+    using map_type       = std::map<Key, T>;
+    using key_type       = Key;
+    using mapped_type    = T;
+    using value_type     = typename map_type::value_type;
+    using const_iterator = typename map_type::const_iterator;
+    using iterator       = const_iterator;
+
+private:
+    std::shared_ptr<map_type> _map;
+
+    map_type& _unshare() {
+        if (!_map) {
+            _map = std::make_shared<map_type>();
+        } else if (_map.use_count() > 1) {
+            _map = std::make_shared<map_type>(*_map);
+        }
+        return *_map;
+    }
+
+public:
+    shared_object() = default;
+    explicit shared_object(map_type members)
+        : _map(std::make_shared<map_type>(std::move(members))) {}
+
+    const map_type& members() const noexcept {
+        static const map_type empty;
+        return _map ? *_map : empty;
+    }
+
+    std::size_t    size() const noexcept { return members().size(); }
+    bool           empty() const noexcept { return members().empty(); }
+    const_iterator begin() const noexcept { return members().begin(); }
+    const_iterator end() const noexcept { return members().end(); }
+    const_iterator find(const Key& key) const { return members().find(key); }
+    std::size_t    count(const Key& key) const { return members().count(key); }
+    const T&       at(const Key& key) const { return members().at(key); }
+
+    template <typename... Args>
+    std::pair<const_iterator, bool> emplace(Args&&... args) {
+        return _unshare().emplace(std::forward<Args>(args)...);
+    }
+
+    /// Whether both objects refer to the same members
+    bool shares_with(const shared_object& other) const noexcept { return _map == other._map; }
+
+    friend bool operator==(const shared_object& lhs, const shared_object& rhs) {
+        return lhs._map == rhs._map || lhs.members() == rhs.members();
+    }
+    friend bool operator!=(const shared_object& lhs, const shared_object& rhs) {
+        return !(lhs == rhs);
+    }
+    friend bool operator<(const shared_object& lhs, const shared_object& rhs) {
+        return lhs.members() < rhs.members();
+    }
+    friend bool operator<=(const shared_object& lhs, const shared_object& rhs) {
+        return !(rhs < lhs);
+    }
+    friend bool operator>(const shared_object& lhs, const shared_object& rhs) {
+        return rhs < lhs;
+    }
+    friend bool operator>=(const shared_object& lhs, const shared_object& rhs) {
+        return !(lhs < rhs);
+    }
+};
+
+/// Data traits in which strings, arrays, and objects may be shared between values
+struct interned_data_traits : default_data_traits {
+    using string_type = shared_string;
+
+    template <typename T>
+    using make_array_type = shared_array<T>;
+
+    template <typename T>
+    using make_object_type = shared_object<shared_string, T>;
+};
+
+using interned_data = basic_data<interned_data_traits>;
+
+/**
+ * Builds data from documents, sharing a single instance between all occurrences of equal
+ * strings, keys, and small subtrees. The instances are kept for the lifetime of the
+ * interner, so those in later documents are shared with those in earlier ones.
+ *
+ * Subtrees are found by their `structural_hash`, which is computed from the hashes of
+ * their children as they are built. Equality of interned values compares storage
+ * pointers first, so comparing two equal interned values is usually immediate.
+ */
+template <typename Data = interned_data>
+class interner {
+    using string_type = typename Data::string_type;
+    using number_type = typename Data::number_type;
+    using array_type  = typename Data::array_type;
+    using object_type = typename Data::mapping_type;
+
+    struct built {
+        Data        value;
+        std::size_t hash;
+        std::size_t nodes;
+    };
+
+    std::size_t                                       _max_subtree_nodes;
+    std::unordered_map<std::string_view, string_type> _strings;
+    std::unordered_multimap<std::size_t, Data>        _subtrees;
+    std::string                                       _scratch;
+
+    string_type _intern(parser& p, std::string_view str, const token& tok) {
+        auto found = _strings.find(str);
+        if (found != _strings.end()) {
+            return found->second;
+        }
+        // Only the first occurrence of a string is allocated
+        detail::charge_allocation(p, str.size(), tok);
+        string_type ret{str};
+        // The key views the string's own storage, which does not move
+        _strings.emplace(std::string_view(ret), ret);
+        return ret;
+    }
+
+    string_type _intern_token(parser& p, token tok) {
+        if (tok.kind == token::identifier) {
+            return _intern(p, tok.spelling, tok);
+        }
+        detail::realize_string_into(tok, _scratch);
+        return _intern(p, _scratch, tok);
+    }
+
+    built _share(built b) {
+        if (b.nodes > _max_subtree_nodes) {
+            return b;
+        }
+        auto [it, stop] = _subtrees.equal_range(b.hash);
+        for (; it != stop; ++it) {
+            if (it->second == b.value) {
+                b.value = it->second;
+                return b;
+            }
+        }
+        _subtrees.emplace(b.hash, b.value);
+        return b;
+    }
+
+    built _scalar(Data value) {
+        const auto hash = structural_hash(value);
+        return {std::move(value), hash, 1};
+    }
+
+    built _build(parser& p, const parse_event& ev) {
+        using pek = parse_event::kind_t;
+        switch (ev.kind) {
+        case pek::number_literal:
+            return _scalar(detail::realize_number<number_type>(ev.token));
+        case pek::boolean_literal:
+            return _scalar(detail::realize_boolean<typename Data::boolean_type>(ev.token));
+        case pek::null_literal:
+            return _scalar(typename Data::null_type());
+        case pek::string_literal:
+            return _scalar(_intern_token(p, ev.token));
+        case pek::array_begin: {
+            std::vector<Data> elems;
+            std::size_t       hash  = detail::hash_array;
+            std::size_t       nodes = 1;
+            for (auto elem_ev = p.next(); elem_ev.kind != pek::array_end; elem_ev = p.next()) {
+                detail::charge_allocation(p, sizeof(Data), elem_ev.token);
+                auto elem = _build(p, elem_ev);
+                hash      = detail::hash_mix(hash, elem.hash);
+                nodes += elem.nodes;
+                elems.push_back(std::move(elem.value));
+            }
+            return _share({array_type(std::move(elems)), hash, nodes});
+        }
+        case pek::object_begin: {
+            typename object_type::map_type members;
+            std::size_t                    sum   = 0;
+            std::size_t                    nodes = 1;
+            for (auto key_ev = p.next(); key_ev.kind != pek::object_end; key_ev = p.next()) {
+                if (key_ev.kind != pek::object_key) {
+                    detail::throw_error(p.error_message(), key_ev.token);
+                }
+                if (key_ev.token.kind != token::identifier
+                    && key_ev.token.kind != token::string_literal) {
+                    detail::throw_error("Invalid object member key token", key_ev.token);
+                }
+                detail::charge_allocation(p,
+                                          sizeof(typename object_type::map_type::value_type),
+                                          key_ev.token);
+                auto key   = _intern_token(p, key_ev.token);
+                auto value = _build(p, p.next());
+                if (members.emplace(key, std::move(value.value)).second) {
+                    // Combined as in structural_hash
+                    const auto key_hash = std::hash<std::string_view>{}(key);
+                    sum += detail::hash_mix(key_hash, value.hash);
+                    nodes += value.nodes;
+                }
+            }
+            return _share({object_type(std::move(members)),
+                           detail::hash_mix(detail::hash_object, sum),
+                           nodes});
+        }
+        case pek::invalid:
+            detail::throw_error(p.error_message(), ev.token);
+        case pek::eof:
+            detail::throw_error("Unexpected end-of-input", ev.token);
+        default:
+            detail::throw_error("Invalid parse event sequence", ev.token);
+        }
+    }
+
+public:
+    /**
+     * Create an interner that shares arrays and objects of up to `max_subtree_nodes`
+     * values, counting every nested value. Strings are always shared.
+     */
+    explicit interner(std::size_t max_subtree_nodes = 64)
+        : _max_subtree_nodes(max_subtree_nodes) {}
+
+    /// Parse a document, sharing its values with those already seen
+    Data parse(std::string_view str, parse_options opts) {
+        parser p{str, opts};
+        auto   ret    = _build(p, p.next()).value;
+        auto   eof_ev = p.next();
+        if (eof_ev.kind != eof_ev.eof) {
+            detail::throw_error("Trailing characters in JSON data", eof_ev.token);
+        }
+        return ret;
+    }
+
+    Data parse(std::string_view str) { return parse(str, parse_options{}); }
+
+    /// The number of distinct strings and subtrees that are held
+    std::size_t size() const noexcept { return _strings.size() + _subtrees.size(); }
+
+    /// Release the held instances. Data that has already been built is unaffected.
+    void clear() noexcept {
+        _strings.clear();
+        _subtrees.clear();
+    }
+};
+
+/**
+ * Parse a document, sharing a single instance between all occurrences of equal strings and
+ * small subtrees within it. See `interner`.
+ */
+template <typename Data = interned_data>
+Data parse_data_interned(std::string_view str, parse_options opts) {
+    return interner<Data>().parse(str, opts);
+}
+
+template <typename Data = interned_data>
+Data parse_data_interned(std::string_view str) {
+    return parse_data_interned<Data>(str, parse_options{});
+}
+
+}  // namespace json5
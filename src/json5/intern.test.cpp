@@ -0,0 +1,62 @@
+#include <json5/intern.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+TEST_CASE("Interned data shares repeated values") {
+    auto doc = json5::parse_data_interned(R"([
+        {status: 'active', unit: 'ms', range: [1, 2]},
+        {status: 'active', unit: 'ms', range: [1, 2]},
+        {status: 'inactive', unit: 'ms', range: [1, 3]},
+    ])");
+    const auto& arr = doc.as_array();
+    REQUIRE(arr.size() == 3);
+    const auto& first  = arr[0].as_object();
+    const auto& second = arr[1].as_object();
+    const auto& third  = arr[2].as_object();
+
+    // The first two objects are identical, so they are one instance
+    CHECK(first.shares_with(second));
+    CHECK_FALSE(first.shares_with(third));
+    CHECK(first.at("unit").as_string().shares_with(third.at("unit").as_string()));
+    CHECK(first.begin()->first.shares_with(third.begin()->first));
+    CHECK(third.at("status") == "inactive");
+    CHECK(third.at("range").as_array()[1] == 3);
+}
+
+TEST_CASE("Interned data matches a normal parse") {
+    auto str = GENERATE(as<std::string>{},
+                        "null",
+                        "'x'",
+                        "[1, [1], [[1]], {a: [1]}, {a: [1]}]",
+                        "{b: 'c', a: {d: true, e: null}, 'f\\n': -0, g: 0}",
+                        "{a: 1, a: 2, b: {a: 1}}");
+    CAPTURE(str);
+    auto interned = json5::parse_data_interned(str);
+    auto plain    = json5::parse_data<json5::interned_data>(str);
+    CHECK(interned == plain);
+    CHECK(json5::structural_hash(interned) == json5::structural_hash(plain));
+}
+
+TEST_CASE("Interners share between documents") {
+    json5::interner<> pool;
+    auto              a = pool.parse("{name: 'widget', tags: ['x', 'y']}");
+    auto              b = pool.parse("['widget', {name: 'widget', tags: ['x', 'y']}]");
+    CHECK(a.as_object().shares_with(b.as_array()[1].as_object()));
+    CHECK(b.as_array()[0].as_string().shares_with(a.as_object().at("name").as_string()));
+    CHECK(pool.size() > 0);
+    pool.clear();
+    CHECK(pool.size() == 0);
+    CHECK_THROWS_AS(pool.parse("[1, 2"), json5::parse_error);
+}
+
+TEST_CASE("Shared containers copy on write") {
+    auto doc  = json5::parse_data<json5::interned_data>("[1, 2]");
+    auto copy = doc;
+    CHECK(copy.as_array().shares_with(doc.as_array()));
+    copy.as_array().push_back(3);
+    CHECK_FALSE(copy.as_array().shares_with(doc.as_array()));
+    CHECK(doc.as_array().size() == 2);
+    CHECK(copy.as_array().size() == 3);
+}
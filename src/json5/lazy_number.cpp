@@ -0,0 +1,255 @@
+#include "./lazy_number.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+using namespace json5;
+
+namespace {
+
+bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+bool is_nonfinite(std::string_view s) noexcept {
+    if (!s.empty() && (s.front() == '+' || s.front() == '-')) {
+        s.remove_prefix(1);
+    }
+    return s == "Infinity" || s == "NaN";
+}
+
+/// 1 for `Infinity`, -1 for `-Infinity`, and 0 for anything else
+int infinity_sign(std::string_view s) noexcept {
+    if (s == "Infinity" || s == "+Infinity") {
+        return 1;
+    }
+    return s == "-Infinity" ? -1 : 0;
+}
+
+/**
+ * A decimal spelling reduced to a sign and the value `0.digits * 10^exponent`, where `digits`
+ * has neither leading nor trailing zeros. Zero has no digits.
+ */
+struct decimal_parts {
+    bool         negative = false;
+    std::string  digits;
+    std::int64_t exponent = 0;
+};
+
+/// Split a decimal spelling into its parts. Returns `false` for any other spelling.
+bool split_decimal(std::string_view s, decimal_parts& out) {
+    if (!s.empty() && (s.front() == '+' || s.front() == '-')) {
+        out.negative = s.front() == '-';
+        s.remove_prefix(1);
+    }
+    const auto int_end  = std::find_if_not(s.begin(), s.end(), is_digit);
+    const auto int_part = s.substr(0, static_cast<std::size_t>(int_end - s.begin()));
+    s.remove_prefix(int_part.size());
+    std::string_view frac_part;
+    if (!s.empty() && s.front() == '.') {
+        s.remove_prefix(1);
+        const auto frac_end = std::find_if_not(s.begin(), s.end(), is_digit);
+        frac_part           = s.substr(0, static_cast<std::size_t>(frac_end - s.begin()));
+        s.remove_prefix(frac_part.size());
+    }
+    if (int_part.empty() && frac_part.empty()) {
+        return false;
+    }
+    std::int64_t exponent = 0;
+    if (!s.empty() && (s.front() == 'e' || s.front() == 'E')) {
+        s.remove_prefix(1);
+        bool exp_negative = false;
+        if (!s.empty() && (s.front() == '+' || s.front() == '-')) {
+            exp_negative = s.front() == '-';
+            s.remove_prefix(1);
+        }
+        if (s.empty() || !std::all_of(s.begin(), s.end(), is_digit)) {
+            return false;
+        }
+        // Clamp absurd exponents. Digit counts can't come close to the clamped value, so the
+        // ordering of such numbers is still right.
+        constexpr std::int64_t exp_limit = std::int64_t(1) << 58;
+        for (char c : s) {
+            exponent = std::min(exponent * 10 + (c - '0'), exp_limit);
+        }
+        if (exp_negative) {
+            exponent = -exponent;
+        }
+        s = {};
+    }
+    if (!s.empty()) {
+        return false;
+    }
+    out.digits.reserve(int_part.size() + frac_part.size());
+    out.digits.append(int_part);
+    out.digits.append(frac_part);
+    out.exponent = exponent + static_cast<std::int64_t>(int_part.size());
+    const auto first_nonzero = out.digits.find_first_not_of('0');
+    if (first_nonzero == out.digits.npos) {
+        out.digits.clear();
+        out.exponent = 0;
+        return true;
+    }
+    out.digits.erase(out.digits.find_last_not_of('0') + 1);
+    out.digits.erase(0, first_nonzero);
+    out.exponent -= static_cast<std::int64_t>(first_nonzero);
+    return true;
+}
+
+/// -1, 0, or 1 as `lhs` is less than, equal to, or greater than `rhs`
+template <typename T>
+int three_way(const T& lhs, const T& rhs) noexcept {
+    return (rhs < lhs) - (lhs < rhs);
+}
+
+/// Compare the magnitudes of two split decimals
+int compare_magnitude(const decimal_parts& lhs, const decimal_parts& rhs) noexcept {
+    if (lhs.digits.empty() || rhs.digits.empty()) {
+        return three_way(!lhs.digits.empty(), !rhs.digits.empty());
+    }
+    if (lhs.exponent != rhs.exponent) {
+        return three_way(lhs.exponent, rhs.exponent);
+    }
+    // Without trailing zeros, the digits compare like the fractions they spell
+    return three_way(lhs.digits.compare(rhs.digits), 0);
+}
+
+double to_double(const std::string& spelling) noexcept {
+    // XXX: GCC 9 is missing from_chars for floating point types. Unlike `stod`, `strtod`
+    // does not throw: numbers beyond the range of a double become HUGE_VAL.
+    return std::strtod(spelling.c_str(), nullptr);
+}
+
+}  // namespace
+
+lazy_number::lazy_number(double d) {
+    if (std::isnan(d)) {
+        _spelling = "NaN";
+    } else if (std::isinf(d)) {
+        _spelling = d < 0 ? "-Infinity" : "Infinity";
+    } else if (std::trunc(d) == d && d >= -0x1p63 && d < 0x1p63) {
+        // An integer that `as_int64()` can read back. `%g` would use an exponent for large
+        // values, so write every digit instead.
+        char buf[32];
+        std::snprintf(buf, sizeof buf, "%.0f", d);
+        _spelling = buf;
+    } else {
+        // XXX: GCC 9 is missing to_chars for floating point types. Find the shortest
+        // precision that round-trips instead.
+        char buf[32];
+        for (int precision = 15; precision <= 17; ++precision) {
+            std::snprintf(buf, sizeof buf, "%.*g", precision, d);
+            if (std::strtod(buf, nullptr) == d) {
+                break;
+            }
+        }
+        _spelling = buf;
+    }
+}
+
+lazy_number lazy_number::from_spelling(std::string_view spelling) {
+    if (!is_nonfinite(spelling)
+        && std::none_of(spelling.begin(), spelling.end(), [](char c) { return is_digit(c); })) {
+        throw std::invalid_argument("Number literal '" + std::string(spelling)
+                                    + "' is not a valid number");
+    }
+    lazy_number ret;
+    ret._spelling = std::string(spelling);
+    return ret;
+}
+
+double lazy_number::as_double() const noexcept { return to_double(_spelling); }
+
+int lazy_number::_compare(const lazy_number& lhs,
+                          const lazy_number& rhs,
+                          bool&              unordered) noexcept {
+    try {
+        decimal_parts l;
+        decimal_parts r;
+        const bool    l_decimal = split_decimal(lhs._spelling, l);
+        const bool    r_decimal = split_decimal(rhs._spelling, r);
+        if (l_decimal && r_decimal) {
+            // Zero is neither positive nor negative
+            const bool l_neg = l.negative && !l.digits.empty();
+            const bool r_neg = r.negative && !r.digits.empty();
+            if (l_neg != r_neg) {
+                return l_neg ? -1 : 1;
+            }
+            return l_neg ? compare_magnitude(r, l) : compare_magnitude(l, r);
+        }
+        // A decimal is finite, even if it does not fit in a double
+        if (l_decimal && infinity_sign(rhs._spelling) != 0) {
+            return -infinity_sign(rhs._spelling);
+        }
+        if (r_decimal && infinity_sign(lhs._spelling) != 0) {
+            return infinity_sign(lhs._spelling);
+        }
+    } catch (const std::bad_alloc&) {
+        // Splitting copies the digits. Fall back to comparing doubles if that fails.
+    }
+    const double l = lhs.as_double();
+    const double r = rhs.as_double();
+    unordered      = std::isnan(l) || std::isnan(r);
+    return unordered ? 0 : three_way(l, r);
+}
+
+std::int64_t lazy_number::as_int64() const {
+    std::string_view s        = _spelling;
+    bool             negative = false;
+    if (!s.empty() && (s.front() == '+' || s.front() == '-')) {
+        negative = s.front() == '-';
+        s.remove_prefix(1);
+    }
+    const auto dot      = s.find('.');
+    auto       int_part = s.substr(0, dot);
+    if (dot != s.npos) {
+        const auto frac = s.substr(dot + 1);
+        if (std::any_of(frac.begin(), frac.end(), [](char c) { return c != '0'; })) {
+            throw std::range_error("Number '" + _spelling + "' is not an integer");
+        }
+    }
+    if (int_part.empty()) {
+        int_part = "0";
+    }
+    std::uint64_t magnitude = 0;
+    auto res = std::from_chars(int_part.data(), int_part.data() + int_part.size(), magnitude);
+    const auto limit = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())
+        + (negative ? 1 : 0);
+    if (res.ec != std::errc() || res.ptr != int_part.data() + int_part.size()
+        || magnitude > limit) {
+        throw std::range_error("Number '" + _spelling
+                               + "' is not representable as a 64-bit integer");
+    }
+    if (negative) {
+        return magnitude == limit ? std::numeric_limits<std::int64_t>::min()
+                                  : -static_cast<std::int64_t>(magnitude);
+    }
+    return static_cast<std::int64_t>(magnitude);
+}
+
+std::string lazy_number::decimal() const {
+    std::string_view s = _spelling;
+    if (is_nonfinite(s)) {
+        return _spelling;
+    }
+    std::string ret;
+    ret.reserve(s.size() + 1);
+    if (s.front() == '+') {
+        s.remove_prefix(1);
+    } else if (s.front() == '-') {
+        ret.push_back('-');
+        s.remove_prefix(1);
+    }
+    while (s.size() > 1 && s[0] == '0' && s[1] != '.') {
+        s.remove_prefix(1);
+    }
+    if (s.front() == '.') {
+        ret.push_back('0');
+    }
+    ret.append(s);
+    return ret;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <json5/data.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace json5 {
+
+/**
+ * A number that retains the spelling of its literal and is only converted when it is read.
+ *
+ * Parsing with `lazy_data` skips the conversion of every number in the document, and
+ * allows integers and decimals that do not fit in a `double` to be re-emitted exactly as
+ * they were written.
+ *
+ * Conversions are not cached, so a `lazy_number` may be read from any number of threads.
+ * Read a value once and keep the result if it is needed repeatedly.
+ *
+ * Comparisons are exact for decimal spellings, however many digits they have, and never
+ * throw.
+ */
+class lazy_number {
+    std::string _spelling = "0";
+
+    /**
+     * Returns -1, 0, or 1 as `lhs` is less than, equal to, or greater than `rhs`. If either is
+     * NaN, sets `unordered` and returns 0.
+     */
+    static int _compare(const lazy_number& lhs, const lazy_number& rhs, bool& unordered) noexcept;
+
+public:
+    lazy_number() = default;
+
+    /**
+     * Create a number from a double. Integers within the range of `std::int64_t` are spelled
+     * with every digit. Otherwise, the spelling is the shortest that round-trips.
+     */
+    lazy_number(double d);
+
+    template <typename Int>
+    requires std::is_integral_v<Int> lazy_number(Int i)
+        : _spelling(std::to_string(i)) {}
+
+    /**
+     * Create a number from the spelling of a JSON5 number literal, as produced by the
+     * tokenizer. Throws `std::invalid_argument` if the spelling contains no digits.
+     */
+    static lazy_number from_spelling(std::string_view spelling);
+
+    /// The spelling of the number, as it appeared in the source
+    std::string_view spelling() const noexcept { return _spelling; }
+
+    /**
+     * Convert to a double. May lose precision. Numbers beyond the range of a double become
+     * positive or negative infinity.
+     */
+    double as_double() const noexcept;
+
+    /**
+     * Convert to a 64-bit integer. Throws `std::range_error` if the number has a non-zero
+     * fractional part or is out of range.
+     */
+    std::int64_t as_int64() const;
+
+    /**
+     * Obtain the number as a plain decimal string that is also valid JSON: Leading `+` and
+     * leading zeros are removed, and a leading `.` is given a zero. No digits are lost.
+     * `Infinity` and `NaN` are returned unchanged.
+     */
+    std::string decimal() const;
+
+    explicit operator double() const { return as_double(); }
+
+    friend bool operator==(const lazy_number& lhs, const lazy_number& rhs) noexcept {
+        bool unordered = false;
+        return _compare(lhs, rhs, unordered) == 0 && !unordered;
+    }
+    friend bool operator!=(const lazy_number& lhs, const lazy_number& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+    friend bool operator<(const lazy_number& lhs, const lazy_number& rhs) noexcept {
+        bool unordered = false;
+        return _compare(lhs, rhs, unordered) < 0 && !unordered;
+    }
+    friend bool operator<=(const lazy_number& lhs, const lazy_number& rhs) noexcept {
+        bool unordered = false;
+        return _compare(lhs, rhs, unordered) <= 0 && !unordered;
+    }
+    friend bool operator>(const lazy_number& lhs, const lazy_number& rhs) noexcept {
+        bool unordered = false;
+        return _compare(lhs, rhs, unordered) > 0 && !unordered;
+    }
+    friend bool operator>=(const lazy_number& lhs, const lazy_number& rhs) noexcept {
+        bool unordered = false;
+        return _compare(lhs, rhs, unordered) >= 0 && !unordered;
+    }
+};
+
+struct lazy_data_traits : default_data_traits {
+    using number_type = lazy_number;
+};
+
+using lazy_data = basic_data<lazy_data_traits>;
+
+}  // namespace json5
@@ -0,0 +1,90 @@
+#include <json5/lazy_number.hpp>
+
+#include <json5/parse_data.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+TEST_CASE("Parse numbers lazily") {
+    auto v = json5::parse_data<json5::lazy_data>(
+        "[12345678901234567890123, 0.1000000000000000000001, +7, -.5, Infinity]");
+    const auto& arr = v.as_array();
+    CHECK(arr[0].as_number().spelling() == "12345678901234567890123");
+    CHECK(arr[1].as_number().spelling() == "0.1000000000000000000001");
+    CHECK(arr[1].as_number().as_double() == 0.1);
+    CHECK(arr[2].as_number().as_int64() == 7);
+    CHECK(arr[3].as_number().as_double() == -0.5);
+    CHECK(std::isinf(arr[4].as_number().as_double()));
+}
+
+TEST_CASE("Convert lazy numbers to integers") {
+    CHECK(json5::lazy_number::from_spelling("-42").as_int64() == -42);
+    CHECK(json5::lazy_number::from_spelling("3.000").as_int64() == 3);
+    CHECK(json5::lazy_number::from_spelling("9223372036854775807").as_int64()
+          == INT64_MAX);
+    CHECK(json5::lazy_number::from_spelling("-9223372036854775808").as_int64()
+          == INT64_MIN);
+    CHECK_THROWS_AS(json5::lazy_number::from_spelling("9223372036854775808").as_int64(),
+                    std::range_error);
+    CHECK_THROWS_AS(json5::lazy_number::from_spelling("1.5").as_int64(), std::range_error);
+    CHECK_THROWS_AS(json5::lazy_number::from_spelling("NaN").as_int64(), std::range_error);
+}
+
+TEST_CASE("Lazy number decimal strings") {
+    CHECK(json5::lazy_number::from_spelling("+007.50").decimal() == "7.50");
+    CHECK(json5::lazy_number::from_spelling("-.25").decimal() == "-0.25");
+    CHECK(json5::lazy_number::from_spelling("0").decimal() == "0");
+    CHECK(json5::lazy_number::from_spelling("123456789012345678901234567890").decimal()
+          == "123456789012345678901234567890");
+}
+
+TEST_CASE("Construct lazy numbers") {
+    CHECK(json5::lazy_number(0.1).spelling() == "0.1");
+    CHECK(json5::lazy_number(1.0 / 3).as_double() == 1.0 / 3);
+    CHECK(json5::lazy_number(12).spelling() == "12");
+    CHECK(json5::lazy_data(5) == json5::lazy_data(json5::lazy_number(5.0)));
+
+    // Large integral doubles are spelled without an exponent
+    CHECK(json5::lazy_number(1e15).spelling() == "1000000000000000");
+    CHECK(json5::lazy_number(1e15).as_int64() == 1'000'000'000'000'000);
+    CHECK(json5::lazy_number(-1e18).decimal() == "-1000000000000000000");
+    CHECK(json5::lazy_number(-0x1p63).as_int64() == std::numeric_limits<std::int64_t>::min());
+    CHECK(json5::lazy_number(1e300).as_double() == 1e300);
+    CHECK_THROWS_AS(json5::lazy_number(0x1p63).as_int64(), std::range_error);
+    CHECK_THROWS_AS(json5::parse_data<json5::lazy_data>("[-]"), std::invalid_argument);
+}
+
+TEST_CASE("Compare lazy numbers exactly") {
+    using json5::lazy_number;
+    // Beyond the range of a double
+    auto huge = json5::parse_data<json5::lazy_data>("[1" + std::string(400, '0') + "]");
+    CHECK(huge == huge);
+    CHECK(std::isinf(huge.as_array()[0].as_number().as_double()));
+    CHECK(lazy_number::from_spelling("1" + std::string(400, '0'))
+          < lazy_number::from_spelling("2" + std::string(400, '0')));
+    CHECK(lazy_number::from_spelling("-1" + std::string(400, '0'))
+          < lazy_number::from_spelling("-.5"));
+    CHECK(lazy_number::from_spelling("0." + std::string(400, '0') + "1")
+          > lazy_number::from_spelling("0"));
+
+    // Integers that round to the same double
+    CHECK(lazy_number::from_spelling("12345678901234567890")
+          != lazy_number::from_spelling("12345678901234567891"));
+    CHECK(lazy_number::from_spelling("12345678901234567890")
+          < lazy_number::from_spelling("12345678901234567891"));
+    CHECK(lazy_number::from_spelling("-12345678901234567891")
+          < lazy_number::from_spelling("-12345678901234567890"));
+
+    // Different spellings of the same value
+    CHECK(lazy_number::from_spelling("+007.50") == lazy_number::from_spelling("7.5"));
+    CHECK(lazy_number::from_spelling("-0") == lazy_number::from_spelling("0.0"));
+    CHECK(lazy_number(1e300) == lazy_number::from_spelling("1" + std::string(300, '0')));
+    CHECK(lazy_number::from_spelling("Infinity") > lazy_number::from_spelling("1e400"));
+    CHECK_FALSE(lazy_number::from_spelling("NaN") == lazy_number::from_spelling("NaN"));
+    CHECK_FALSE(lazy_number::from_spelling("NaN") <= lazy_number::from_spelling("1"));
+    CHECK_FALSE(lazy_number::from_spelling("NaN") >= lazy_number::from_spelling("1"));
+    CHECK(lazy_number::from_spelling("NaN") != lazy_number::from_spelling("1"));
+}
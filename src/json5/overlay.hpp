@@ -0,0 +1,231 @@
+#pragma once
+
+#include <json5/data.hpp>
+#include <json5/projection.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace json5 {
+
+/**
+ * Apply a JSON Merge Patch (RFC 7396) to `target`: If `patch` is an object, each of its
+ * members is merged into the matching member of `target` (which is first made an object
+ * if it is not one), and a member that is null removes the member from `target`. Any other
+ * `patch` replaces `target` entirely.
+ */
+template <typename Data>
+void merge_patch(Data& target, const Data& patch) {
+    using object_type = typename Data::mapping_type;
+    if (!patch.is_object()) {
+        target = patch;
+        return;
+    }
+    if (!target.is_object()) {
+        target = object_type();
+    }
+    auto& obj = target.as_object();
+    for (const auto& [key, value] : patch.as_object()) {
+        if (value.is_null()) {
+            obj.erase(key);
+        } else {
+            merge_patch(obj[key], value);
+        }
+    }
+}
+
+namespace detail {
+
+/// Parse a JSON Pointer array index, which has no sign and no leading zeros
+inline bool parse_pointer_index(std::string_view segment, std::size_t& out) noexcept {
+    if (segment.empty() || (segment.size() > 1 && segment.front() == '0')) {
+        return false;
+    }
+    auto res = std::from_chars(segment.data(), segment.data() + segment.size(), out);
+    return res.ec == std::errc() && res.ptr == segment.data() + segment.size();
+}
+
+/// Descend from `node` through the given segments, or return `nullptr` if there is no value
+template <typename Data>
+const Data* find_by_segments(const Data*                     node,
+                             const std::vector<std::string>& segments,
+                             std::size_t                     first) {
+    for (auto it = segments.begin() + static_cast<std::ptrdiff_t>(first);
+         node && it != segments.end();
+         ++it) {
+        if (node->is_object()) {
+            const auto& obj   = node->as_object();
+            auto        found = obj.find(typename Data::mapping_type::key_type(*it));
+            node              = found == obj.end() ? nullptr : &found->second;
+        } else if (std::size_t idx = 0;
+                   node->is_array() && parse_pointer_index(*it, idx)
+                   && idx < node->as_array().size()) {
+            node = &node->as_array()[idx];
+        } else {
+            node = nullptr;
+        }
+    }
+    return node;
+}
+
+}  // namespace detail
+
+/**
+ * A read-only view of a stack of configuration layers, merged lazily.
+ *
+ * The first layer is the base document. Each later layer is applied to the layers below it
+ * as a JSON Merge Patch (RFC 7396), so that objects are merged member-by-member, a null
+ * member removes a member, and any other value replaces what was below it.
+ *
+ * Looking up a path only visits the layers along that path. A value that comes from a
+ * single layer is returned in place, and only an object that is merged from several layers
+ * is built. Built values are cached by path until the layers are changed. `flatten()`
+ * builds the entire merged document.
+ *
+ * The layers are not copied, and must outlive the overlay. Lookups are safe to make from
+ * multiple threads, but changing the layers is not.
+ */
+template <typename Data = data>
+class overlay {
+    struct cache_entry {
+        const Data*           value = nullptr;
+        std::unique_ptr<Data> owned;
+    };
+
+    std::vector<const Data*> _layers;
+
+    mutable std::mutex                                   _cache_mutex;
+    mutable std::unordered_map<std::string, cache_entry> _cache;
+
+    cache_entry _resolve(const std::vector<std::string>& segments) const {
+        const auto depth = segments.size();
+        // The values of the patch layers that are objects at this path, from the top down
+        std::vector<const Data*> patches;
+        // The value beneath those patches, if any
+        const Data* base = nullptr;
+        // Lower layers only contribute if their values at this many leading prefixes of the
+        // path are objects, since a patch object would otherwise have replaced them.
+        std::size_t need_object = 0;
+
+        for (auto layer = _layers.size(); layer-- > 0;) {
+            const bool  is_patch = layer > 0;
+            const Data* node     = _layers[layer];
+            bool        next     = false;
+            bool        stop     = false;
+            for (std::size_t j = 0; j <= depth && !next && !stop; ++j) {
+                if (j < need_object && !node->is_object()) {
+                    // Replaced by a patch object above
+                    stop = true;
+                } else if (j == depth) {
+                    if (is_patch && node->is_object()) {
+                        patches.push_back(node);
+                        need_object = depth + 1;
+                        next        = true;
+                    } else {
+                        base = node;
+                        stop = true;
+                    }
+                } else if (node->is_object()) {
+                    const auto& obj = node->as_object();
+                    auto found = obj.find(typename Data::mapping_type::key_type(segments[j]));
+                    if (found == obj.end()) {
+                        if (!is_patch) {
+                            stop = true;
+                        } else {
+                            // This layer leaves the path as it is below
+                            need_object = std::max(need_object, j + 1);
+                            next        = true;
+                        }
+                    } else if (is_patch && found->second.is_null()) {
+                        // Removed by this layer
+                        stop = true;
+                    } else {
+                        node = &found->second;
+                    }
+                } else {
+                    // The layer replaces everything from here down with a non-object
+                    base = detail::find_by_segments(node, segments, j);
+                    stop = true;
+                }
+            }
+            if (stop) {
+                break;
+            }
+        }
+
+        cache_entry ret;
+        if (patches.empty()) {
+            ret.value = base;
+            return ret;
+        }
+        ret.owned = std::make_unique<Data>(typename Data::mapping_type());
+        if (base && base->is_object()) {
+            *ret.owned = *base;
+        }
+        for (auto it = patches.rbegin(); it != patches.rend(); ++it) {
+            merge_patch(*ret.owned, **it);
+        }
+        ret.value = ret.owned.get();
+        return ret;
+    }
+
+public:
+    overlay() = default;
+
+    /// Create an overlay of the given layers, from the lowest priority to the highest
+    explicit overlay(std::vector<const Data*> layers)
+        : _layers(std::move(layers)) {}
+
+    overlay(const overlay&) = delete;
+    overlay& operator=(const overlay&) = delete;
+
+    /// Add a layer with a higher priority than all of the existing layers
+    void push_layer(const Data& layer) {
+        _layers.push_back(&layer);
+        clear_cache();
+    }
+
+    /// The number of layers
+    std::size_t size() const noexcept { return _layers.size(); }
+
+    /**
+     * Find the merged value at the given JSON Pointer, or return `nullptr` if there is
+     * none. The returned value remains valid until the layers or the cache are changed.
+     * Throws `std::invalid_argument` if the pointer is malformed.
+     */
+    const Data* find(std::string_view pointer) const {
+        if (_layers.empty()) {
+            return nullptr;
+        }
+        std::lock_guard lock{_cache_mutex};
+        auto            found = _cache.find(std::string(pointer));
+        if (found != _cache.end()) {
+            return found->second.value;
+        }
+        auto entry = _resolve(detail::split_pointer(pointer));
+        return _cache.emplace(std::string(pointer), std::move(entry)).first->second.value;
+    }
+
+    bool contains(std::string_view pointer) const { return find(pointer) != nullptr; }
+
+    /// Build the entire merged document. With no layers, this is null.
+    Data flatten() const {
+        auto root = find("");
+        return root ? *root : Data();
+    }
+
+    /// Drop the cached values. Previously returned values are no longer valid.
+    void clear_cache() {
+        std::lock_guard lock{_cache_mutex};
+        _cache.clear();
+    }
+};
+
+}  // namespace json5
@@ -0,0 +1,157 @@
+#include <json5/overlay.hpp>
+
+#include <json5/parse_data.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <string>
+
+namespace {
+
+json5::data random_value(std::mt19937& rng, int depth) {
+    const char* const keys[] = {"a", "b", "c"};
+    const auto        kind   = std::uniform_int_distribution<int>{0, depth > 0 ? 5 : 3}(rng);
+    switch (kind) {
+    case 0:
+        return json5::data();
+    case 1:
+        return std::uniform_int_distribution<int>{0, 9}(rng);
+    case 2:
+        return "str";
+    case 3:
+        return true;
+    case 4: {
+        json5::data::array_type arr;
+        arr.push_back(random_value(rng, depth - 1));
+        return arr;
+    }
+    default: {
+        json5::data::mapping_type obj;
+        for (auto key : keys) {
+            if (std::uniform_int_distribution<int>{0, 2}(rng)) {
+                obj.emplace(key, random_value(rng, depth - 1));
+            }
+        }
+        return obj;
+    }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Merge patch") {
+    // The examples from RFC 7396
+    auto check = [](std::string_view target, std::string_view patch, std::string_view expect) {
+        auto data = json5::parse_data(target);
+        json5::merge_patch(data, json5::parse_data(patch));
+        CHECK(data == json5::parse_data(expect));
+    };
+    check("{a: 'b'}", "{a: 'c'}", "{a: 'c'}");
+    check("{a: 'b'}", "{b: 'c'}", "{a: 'b', b: 'c'}");
+    check("{a: 'b'}", "{a: null}", "{}");
+    check("{a: 'b', b: 'c'}", "{a: null}", "{b: 'c'}");
+    check("{a: ['b']}", "{a: 'c'}", "{a: 'c'}");
+    check("{a: 'c'}", "{a: ['b']}", "{a: ['b']}");
+    check("{a: {b: 'c'}}", "{a: {b: 'd', c: null}}", "{a: {b: 'd'}}");
+    check("{a: [{b: 'c'}]}", "{a: [1]}", "{a: [1]}");
+    check("['a', 'b']", "['c', 'd']", "['c', 'd']");
+    check("{a: 'b'}", "['c']", "['c']");
+    check("{a: 'foo'}", "null", "null");
+    check("{a: 'foo'}", "'bar'", "'bar'");
+    check("{e: null}", "{a: 1}", "{e: null, a: 1}");
+    check("[1, 2]", "{a: 'b', c: null}", "{a: 'b'}");
+    check("{}", "{a: {bb: {ccc: null}}}", "{a: {bb: {}}}");
+}
+
+TEST_CASE("Overlay layers") {
+    const auto defaults = json5::parse_data(R"({
+        server: {host: 'localhost', port: 8080, tls: {enabled: false}},
+        log: {level: 'info', sinks: ['stderr']},
+        features: {beta: true},
+    })");
+    const auto site     = json5::parse_data(R"({
+        server: {host: 'example.com', tls: {enabled: true, cert: '/etc/cert'}},
+        features: null,
+    })");
+    const auto user     = json5::parse_data("{log: {sinks: ['file']}, server: {port: 9000}}");
+
+    json5::overlay<> ov{{&defaults, &site, &user}};
+    CHECK(ov.size() == 3);
+
+    // Values that come from a single layer are returned in place
+    CHECK(ov.find("/server/host") == &site.as_object().at("server").as_object().at("host"));
+    CHECK(ov.find("/log/level") == &defaults.as_object().at("log").as_object().at("level"));
+    CHECK(*ov.find("/server/port") == 9000);
+    CHECK(*ov.find("/log/sinks") == json5::parse_data("['file']"));
+    CHECK(*ov.find("/log/sinks/0") == "file");
+    CHECK_FALSE(ov.contains("/log/sinks/1"));
+
+    // Removed by a null
+    CHECK_FALSE(ov.contains("/features"));
+    CHECK_FALSE(ov.contains("/features/beta"));
+    CHECK_FALSE(ov.contains("/missing"));
+
+    // Objects that appear in several layers are merged
+    CHECK(*ov.find("/server/tls") == json5::parse_data("{enabled: true, cert: '/etc/cert'}"));
+    const auto merged = ov.find("/server");
+    CHECK(*merged == json5::parse_data(R"({host: 'example.com', port: 9000,
+                                           tls: {enabled: true, cert: '/etc/cert'}})"));
+    // Merged values are cached
+    CHECK(ov.find("/server") == merged);
+
+    CHECK(ov.flatten() == json5::parse_data(R"({
+        server: {host: 'example.com', port: 9000, tls: {enabled: true, cert: '/etc/cert'}},
+        log: {level: 'info', sinks: ['file']},
+    })"));
+
+    const auto last = json5::parse_data("{log: 'off'}");
+    ov.push_layer(last);
+    CHECK(*ov.find("/log") == "off");
+    CHECK_FALSE(ov.contains("/log/level"));
+
+    CHECK_THROWS_AS(ov.find("no-slash"), std::invalid_argument);
+    CHECK(json5::overlay<>{}.flatten() == json5::data());
+}
+
+TEST_CASE("Overlay agrees with eager merging") {
+    const char* const paths[] = {"",
+                                 "/a",
+                                 "/b",
+                                 "/a/a",
+                                 "/a/b",
+                                 "/a/0",
+                                 "/b/c",
+                                 "/a/b/c",
+                                 "/a/0/a",
+                                 "/c/a/0",
+                                 "/a/b/c/a"};
+    std::mt19937      rng{7396};
+    for (int round = 0; round < 500; ++round) {
+        std::vector<json5::data> layers;
+        const auto n_layers = std::uniform_int_distribution<int>{1, 4}(rng);
+        for (int i = 0; i < n_layers; ++i) {
+            layers.push_back(random_value(rng, 3));
+        }
+        json5::overlay<> ov;
+        json5::data      expected = layers.front();
+        for (auto& layer : layers) {
+            ov.push_layer(layer);
+            if (&layer != &layers.front()) {
+                json5::merge_patch(expected, layer);
+            }
+        }
+        for (auto path : paths) {
+            INFO("Path: " << path);
+            const auto want = json5::detail::find_by_segments(&expected,
+                                                              json5::detail::split_pointer(path),
+                                                              0);
+            const auto got  = ov.find(path);
+            REQUIRE((want == nullptr) == (got == nullptr));
+            if (want) {
+                CHECK(*got == *want);
+            }
+        }
+        CHECK(ov.flatten() == expected);
+    }
+}
@@ -1,7 +1,10 @@
 #include "./parse.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <new>
 #include <stdexcept>
+#include <utility>
 
 using namespace json5;
 
@@ -28,6 +31,10 @@ namespace json5::detail {
  * Because the length of the bit array is fixed, this imposes a limitation in
  * the nesting depth that can be tracked by the parser. Exceeding this limit
  * will produce an error event.
+ *
+ * The one exception is `parse_limits::max_elements`: If it is set, the element
+ * count of each enclosing array/object is saved on a stack while a nested one is
+ * open.
  */
 
 struct parser_impl {
@@ -46,9 +53,36 @@ struct parser_impl {
     /// Set the next parser state
     void become(parser::state_t st) noexcept { self._state = st; }
 
+    /// Whether the element counts of open arrays/objects are tracked
+    bool counts_elements() const noexcept {
+        return self._opts.limits.max_elements != SIZE_MAX;
+    }
+
+    /// Count a new value against the limits. Returns an error message if one is exceeded.
+    std::string_view count_value() noexcept {
+        const auto& limits = self._opts.limits;
+        if (++self._n_values > limits.max_nodes) {
+            return "Document exceeds the value limit";
+        }
+        if (counts_elements() && self._nest_depth && ++self._elem_count > limits.max_elements) {
+            return "Array/object exceeds the element limit";
+        }
+        return {};
+    }
+
+    /// Check the length of a string literal or identifier key against the limits
+    bool string_too_long(const token& tok) const noexcept {
+        const auto len = tok.kind == token::string_literal ? tok.spelling.size() - 2
+                                                           : tok.spelling.size();
+        return len > self._opts.limits.max_string_length;
+    }
+
     /// Generate a value event and transition to the next state based on our
     /// current parsing context
     parse_event value(parse_event::kind_t k) noexcept {
+        if (auto err = count_value(); !err.empty()) {
+            return fail(err);
+        }
         if (in_object()) {
             // We need to parse an object tail next
             become(self.object_tail);
@@ -63,6 +97,34 @@ struct parser_impl {
         return parse_event{k, curtok()};
     }
 
+    /// Advance the tokenizer by one token
+    void advance() noexcept {
+        self._toks.advance();
+        update_stats(self._opts, [&](parse_stats& stats) {
+            ++stats.tokens[kind()];
+            stats.bytes += self._toks.offset() - self._stats_offset;
+            self._stats_offset = self._toks.offset();
+        });
+    }
+
+    /// Enter a new array/object nesting level. Returns an error message if that fails.
+    std::string_view push_depth() noexcept {
+        if (counts_elements()) {
+            try {
+                self._outer_elem_counts.push_back(self._elem_count);
+            } catch (const std::bad_alloc&) {
+                return "Out of memory for array/object nesting";
+            }
+            self._elem_count = 0;
+        }
+        ++self._nest_depth;
+        self._nest_flag_bits <<= 1;
+        update_stats(self._opts, [&](parse_stats& stats) {
+            stats.max_depth = std::max(stats.max_depth, self._nest_depth);
+        });
+        return {};
+    }
+
     /// Set the error message and return an error event
     parse_event fail(std::string_view error_message) noexcept {
         self._error_message = error_message;
@@ -80,20 +142,41 @@ struct parser_impl {
     */
     // Return the next parser event
     parse_event parse_next() noexcept {
+        const auto max_bytes = self._opts.limits.max_bytes;
+        // Input that was discarded by `rebase()` still counts towards the size
+        if (!self._streaming && self._n_discarded + self._toks.size() > max_bytes) {
+            return fail("Input exceeds the size limit");
+        }
+
         // Advance one token,
-        self._toks.advance();
+        advance();
         // And skip all comments. They have no effect on parser state.
         while (kind() == token::comment) {
             if (self._opts.c_comments == toggle::off) {
                 return fail("Comments are not allowed.");
             }
-            self._toks.advance();
+            advance();
         }
 
         if (kind() == token::unterm_comment) {
             return fail("Unterminated block comment");
         }
 
+        if (kind() == token::invalid_utf8) {
+            return fail("Invalid UTF-8 in input");
+        }
+
+        if (self._streaming && max_bytes != SIZE_MAX && kind() != token::eof) {
+            const auto end = self._toks.offset();
+            if (self._state == self.top) {
+                // The first token of a document
+                self._doc_start = end - curtok().spelling.size();
+            }
+            if (end - self._doc_start > max_bytes) {
+                return fail("Input exceeds the size limit");
+            }
+        }
+
         // If the token emitter has nothing more, then we have nothing more.
         if (self._toks.done()) {
             self._done = true;
@@ -202,6 +285,9 @@ struct parser_impl {
                 && curtok().spelling.find('\n') != std::string_view::npos) {
                 return fail("Escaped newlines in strings are not allowed.");
             }
+            if (string_too_long(curtok())) {
+                return fail("String exceeds the length limit");
+            }
             return parse_event{parse_event::object_key, curtok()};
         /// Unexpected end-of-file
         case token::eof:
@@ -297,6 +383,9 @@ struct parser_impl {
                 && tok.spelling.find('\n') != std::string_view::npos) {
                 return fail("Escaped newlines in strings are not allowed.");
             }
+            if (string_too_long(tok)) {
+                return fail("String exceeds the length limit");
+            }
             return value(parse_event::string_literal);
         case tok.number_literal:
             return value(parse_event::number_literal);
@@ -338,7 +427,8 @@ struct parser_impl {
             return fail("Invalid token");
         case tok.comment:
         case tok.unterm_comment:
-            assert(false && "Unreachable (comment token)");
+        case tok.invalid_utf8:
+            assert(false && "Unreachable (comment or invalid UTF-8 token)");
             break;
         }
         assert(false && "Unreachable");
@@ -349,6 +439,10 @@ struct parser_impl {
         assert(self._nest_depth > 0);
         --self._nest_depth;
         self._nest_flag_bits >>= 1;
+        if (counts_elements()) {
+            self._elem_count = self._outer_elem_counts.back();
+            self._outer_elem_counts.pop_back();
+        }
         if (in_object()) {
             become(self.object_tail);
         } else if (in_array()) {
@@ -359,11 +453,16 @@ struct parser_impl {
     }
 
     parse_event array_begin() noexcept {
-        if (self._nest_depth == self._nest_flag_bits.size()) {
+        if (self._nest_depth == self._nest_flag_bits.size()
+            || self._nest_depth >= self._opts.limits.max_depth) {
             return fail("Array/object nesting is too deep.");
         }
-        ++self._nest_depth;
-        self._nest_flag_bits <<= 1;
+        if (auto err = count_value(); !err.empty()) {
+            return fail(err);
+        }
+        if (auto err = push_depth(); !err.empty()) {
+            return fail(err);
+        }
         self._nest_flag_bits[0] = 0;
         // We always set our new state to be to expect an array value
         become(self.array_value_or_close);
@@ -376,11 +475,16 @@ struct parser_impl {
     }
 
     parse_event object_begin() noexcept {
-        if (self._nest_depth == self._nest_flag_bits.size()) {
+        if (self._nest_depth == self._nest_flag_bits.size()
+            || self._nest_depth >= self._opts.limits.max_depth) {
             return fail("Array/object nesting is too deep.");
         }
-        ++self._nest_depth;
-        self._nest_flag_bits <<= 1;
+        if (auto err = count_value(); !err.empty()) {
+            return fail(err);
+        }
+        if (auto err = push_depth(); !err.empty()) {
+            return fail(err);
+        }
         self._nest_flag_bits[0] = 1;
         // We always set our new state to be to expect an object member
         become(self.object_key_or_close);
@@ -395,4 +499,28 @@ struct parser_impl {
 
 }  // namespace json5::detail
 
-parse_event parser::next() noexcept { return detail::parser_impl{*this}.parse_next(); }
\ No newline at end of file
+parse_event parser::next() noexcept {
+    _lookahead_valid = false;
+    return detail::parser_impl{*this}.parse_next();
+}
+
+std::size_t parser::next_event_end() const noexcept {
+    auto& toks = _lookahead;
+    if (_lookahead_valid) {
+        // The tokens before the last one that was read are complete. Only the last one can
+        // have been cut off by the end of the old buffer.
+        toks.rescan();
+    } else {
+        toks = _toks;
+        toks.advance();
+        _lookahead_valid = true;
+    }
+    // An event reads any comments before its token, and the value or closing bracket that
+    // follows a `,` or `:`
+    while (!toks.done()
+           && (toks.current_kind() == token::comment || toks.current_kind() == token::punct_comma
+               || toks.current_kind() == token::punct_colon)) {
+        toks.advance();
+    }
+    return toks.offset();
+}
\ No newline at end of file
@@ -2,7 +2,20 @@
 
 #include <json5/tokenize.hpp>
 
+#include <algorithm>
 #include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+/**
+ * Parse statistics are compiled out unless this is defined to a non-zero value when
+ * compiling both the library and the code that uses it.
+ */
+#ifndef JSON5_ENABLE_STATS
+#define JSON5_ENABLE_STATS 0
+#endif
 
 namespace json5 {
 
@@ -17,14 +30,91 @@ enum class toggle {
     on,
 };
 
+/**
+ * Counters that are updated while parsing, if enabled with `JSON5_ENABLE_STATS`. Counters
+ * accumulate across parses that share the same `parse_stats` object.
+ */
+struct parse_stats {
+    /// The number of tokens read, indexed by `token::kind_t`
+    std::size_t tokens[token::eof + 1] = {};
+    /// The number of input bytes consumed
+    std::size_t bytes = 0;
+    /// The deepest array/object nesting that was reached
+    std::size_t max_depth = 0;
+    /// The number of string literals that were unescaped by a data builder
+    std::size_t strings_unescaped = 0;
+    /// The number of number literals that were converted by a data builder
+    std::size_t numbers_parsed = 0;
+    /// The number of strings, arrays, and objects created by a data builder
+    std::size_t allocations = 0;
+
+    /// Add the statistics of a separate parse, such as of another part of the same input
+    void merge(const parse_stats& other) noexcept {
+        for (std::size_t i = 0; i != std::size(tokens); ++i) {
+            tokens[i] += other.tokens[i];
+        }
+        bytes             += other.bytes;
+        max_depth         = std::max(max_depth, other.max_depth);
+        strings_unescaped += other.strings_unescaped;
+        numbers_parsed    += other.numbers_parsed;
+        allocations       += other.allocations;
+    }
+};
+
+/**
+ * Bounds on the resources that parsing a single document may use, for reading untrusted
+ * input. A document that exceeds any of them fails to parse with an error that names the
+ * limit. By default, nothing is limited except by the parser's fixed maximum nesting depth.
+ */
+struct parse_limits {
+    /// The maximum size of the input, in bytes
+    std::size_t max_bytes = SIZE_MAX;
+    /// The maximum array/object nesting depth. Values above 1024 have no effect.
+    std::size_t max_depth = 1024;
+    /// The maximum length of a string literal or object key, in bytes as written
+    std::size_t max_string_length = SIZE_MAX;
+    /// The maximum number of elements of an array or members of an object
+    std::size_t max_elements = SIZE_MAX;
+    /// The maximum number of values in the document, including every nested value
+    std::size_t max_nodes = SIZE_MAX;
+    /// The maximum number of bytes that a data builder may allocate. This is estimated from
+    /// the sizes of values, keys, and strings, and excludes allocator overhead.
+    std::size_t max_allocated_bytes = SIZE_MAX;
+};
+
 struct parse_options {
     toggle c_comments             = toggle::on;
     toggle trailing_commas        = toggle::on;
     toggle bare_ident_keys        = toggle::on;
     toggle single_quote_strings   = toggle::on;
     toggle escape_newline_strings = toggle::on;
+
+    /// Pre-compute the size of each array and object of a document with a quick structural
+    /// scan before building data from it. Containers that support `reserve()` are then
+    /// allocated exactly once. This costs an extra pass over the input.
+    toggle presize_containers = toggle::off;
+
+    /// Statistics to update during parsing. Ignored unless `JSON5_ENABLE_STATS` is set.
+    parse_stats* stats = nullptr;
+
+    /// Resource limits for each document
+    parse_limits limits = {};
 };
 
+namespace detail {
+
+/// Invoke the given function with the parse statistics, if they are enabled and present
+template <typename Func>
+constexpr void update_stats(const parse_options& opts, Func&& fn) {
+    if constexpr (JSON5_ENABLE_STATS) {
+        if (opts.stats) {
+            fn(*opts.stats);
+        }
+    }
+}
+
+}  // namespace detail
+
 constexpr inline parse_options json5_options = {};
 constexpr inline parse_options jsonc_options = {
     .c_comments             = toggle::on,
@@ -74,9 +164,32 @@ class parser {
     std::bitset<1024> _nest_flag_bits;
     std::size_t       _nest_depth = 0;
 
+    /// The number of elements seen so far in the innermost open array/object, and those of
+    /// the enclosing ones. These are only tracked if `max_elements` is limited.
+    std::size_t              _elem_count = 0;
+    std::vector<std::size_t> _outer_elem_counts;
+    /// The number of values seen so far
+    std::size_t _n_values = 0;
+    /// The estimated number of bytes allocated by a data builder
+    std::size_t _allocated = 0;
+    /// Whether the input is a stream of documents, each of which is measured against
+    /// `max_bytes` as it is read, from the offset of its first token
+    bool        _streaming = false;
+    std::size_t _doc_start = 0;
+    /// The number of input bytes that were discarded by `rebase()`. Offsets in the current
+    /// buffer are relative to the end of these.
+    std::size_t _n_discarded = 0;
+
     std::string_view _error_message;
 
+    /// The tokens read ahead by `next_event_end()`. They are kept until the next call to
+    /// `next()`, so that a call after `rebase()` can continue the scan instead of repeating it.
+    mutable tokenizer _lookahead{std::string_view()};
+    mutable bool      _lookahead_valid = false;
+
     parse_options _opts;
+    /// The input offset at which the bytes counter of the parse statistics was last updated
+    std::size_t _stats_offset = 0;
 
     friend struct detail::parser_impl;
 
@@ -145,6 +258,77 @@ public:
     bool        done() const noexcept { return _done; }
 
     std::string_view error_message() const noexcept { return _error_message; }
+
+    const parse_options& options() const noexcept { return _opts; }
+
+    /// The offset in the input of the end of the most recently read token
+    std::size_t offset() const noexcept { return _toks.offset(); }
+
+    /**
+     * The offset in the input of the end of the tokens that the next call to `next()` will
+     * read, found by tokenizing ahead without changing the state of the parser. If the input
+     * is extended with `rebase()` before the next call to `next()`, calling this again
+     * continues the previous scan rather than starting over.
+     */
+    std::size_t next_event_end() const noexcept;
+
+    /// Point the parser at an extended input buffer. See `tokenizer::rebase()`.
+    void rebase(std::string_view buf, std::size_t n_discarded) noexcept {
+        _toks.rebase(buf, n_discarded);
+        if (_lookahead_valid) {
+            _lookahead.rebase(buf, n_discarded);
+        }
+        // These may wrap if they precede the new buffer, but the differences taken between
+        // them and offsets in the new buffer remain correct
+        _doc_start    -= n_discarded;
+        _stats_offset -= n_discarded;
+        _n_discarded  += n_discarded;
+    }
+
+    /**
+     * Add to the estimate of the bytes allocated by a data builder for the current document.
+     * Returns `false` if the estimate exceeds `parse_limits::max_allocated_bytes`.
+     */
+    bool charge_allocation(std::size_t n) noexcept {
+        _allocated += n;
+        return _allocated <= _opts.limits.max_allocated_bytes;
+    }
+
+    /// The number of bytes that may still be charged without exceeding the allocation limit
+    std::size_t allocation_budget() const noexcept {
+        const auto max = _opts.limits.max_allocated_bytes;
+        return _allocated < max ? max - _allocated : 0;
+    }
+
+    /**
+     * Begin the next of a sequence of concatenated documents in the same input. The limits
+     * of `parse_limits` then apply to each document separately: `max_bytes` is measured from
+     * the first token of the document, rather than being checked against the entire input.
+     */
+    void begin_document() noexcept {
+        _streaming = true;
+        _n_values  = 0;
+        _allocated = 0;
+    }
+
+    /// Begin parsing a new document from the given buffer, with the same options
+    void reset(std::string_view buf) noexcept {
+        _toks = tokenizer(buf);
+        _done = false;
+        _nest_flag_bits.reset();
+        _nest_depth = 0;
+        _elem_count = 0;
+        _outer_elem_counts.clear();
+        _n_values        = 0;
+        _allocated       = 0;
+        _streaming       = false;
+        _doc_start       = 0;
+        _n_discarded     = 0;
+        _error_message   = {};
+        _lookahead_valid = false;
+        _stats_offset    = 0;
+        _state           = top;
+    }
 };
 
 }  // namespace json5
\ No newline at end of file
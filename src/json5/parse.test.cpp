@@ -157,6 +157,20 @@ TEST_CASE("Resumable") {
                 });
 }
 
+TEST_CASE("Reset") {
+    json5::parser p{"[1, [2 @"};
+    while (p.next().kind != pek::invalid) {
+    }
+    CHECK(p.error_message() != "");
+    p.reset("{a: 1}");
+    CHECK(p.error_message() == "");
+    CHECK(p.next().kind == pek::object_begin);
+    CHECK(p.next().kind == pek::object_key);
+    CHECK(p.next().kind == pek::number_literal);
+    CHECK(p.next().kind == pek::object_end);
+    CHECK(p.next().kind == pek::eof);
+}
+
 void check_reject(json5::parser& p, std::string_view expect_message) {
     INFO("Expecting message: " << expect_message);
     for (auto ev : p) {
@@ -189,6 +203,8 @@ TEST_CASE("Reject") {
     check_reject("{'foo': 12,,}", "Extraneous `,` in object literal.");
     check_reject("[,]", "Extraneous `,` in array literal.");
     check_reject("foo", "An object key identifier is not a valid value.");
+    check_reject("['caf\xc3']", "Invalid UTF-8 in input");
+    check_reject("[1, /* \xff */ 2]", "Invalid UTF-8 in input");
 }
 
 TEST_CASE("Reject restricted opts") {
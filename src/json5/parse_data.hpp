@@ -2,8 +2,11 @@
 
 #include <json5/data.hpp>
 #include <json5/parse.hpp>
+#include <json5/structure.hpp>
 
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace json5 {
 
@@ -16,16 +19,59 @@ Data parse_next_value(parser& p);
 
 namespace detail {
 
+/**
+ * Container sizes computed by a structural pre-pass. They are taken in the order in which
+ * arrays and objects are opened.
+ */
+struct size_hints {
+    std::vector<std::size_t> sizes;
+    std::size_t              next = 0;
+
+    std::size_t take() noexcept { return next < sizes.size() ? sizes[next++] : 0; }
+};
+
 template <typename Data>
-Data parse_inner(json5::parser& p, const json5::parse_event& ev);
+Data parse_inner(json5::parser& p, const json5::parse_event& ev, size_hints* hints = nullptr);
 
 double parse_double(std::string_view);
 
 [[noreturn]] void throw_error(std::string_view message, token tok);
 
+/// Charge `n` bytes against the parser's allocation limit, or throw if it is exceeded
+inline void charge_allocation(parser& p, std::size_t n, const token& tok) {
+    if (!p.charge_allocation(n)) {
+        throw_error("Document exceeds the allocation limit", tok);
+    }
+}
+
+/**
+ * Reserve room for a pre-computed number of elements in `container`, if the limits allow it.
+ * The room is charged against the allocation limit up front, so the elements that fill it
+ * must not be charged again. Returns the number of elements that room was reserved for.
+ */
+template <typename Container>
+std::size_t reserve_charged(parser& p, Container& container, std::size_t size) {
+    if constexpr (requires { container.reserve(size); }) {
+        constexpr auto elem_size = sizeof(typename Container::value_type);
+        // Don't trust a size that the parser is going to reject
+        if (size <= p.options().limits.max_elements
+            && size <= p.allocation_budget() / elem_size) {
+            p.charge_allocation(size * elem_size);
+            container.reserve(size);
+            return size;
+        }
+    }
+    return 0;
+}
+
 template <typename T>
 T realize_number(token tok) {
-    return T(parse_double(tok.spelling));
+    if constexpr (requires { T::from_spelling(tok.spelling); }) {
+        // The number type keeps the spelling and converts it itself
+        return T::from_spelling(tok.spelling);
+    } else {
+        return T(parse_double(tok.spelling));
+    }
 }
 
 template <typename T>
@@ -37,8 +83,12 @@ T realize_boolean(token tok) {
     }
 }
 
+/**
+ * Unescape a string literal token into `ret`, replacing its contents. The existing capacity
+ * of `ret` is reused.
+ */
 template <typename String>
-String realize_string(token tok) {
+void realize_string_into(token tok, String& ret) {
     auto spelling = tok.spelling;
     if (spelling.size() < 2) {
         throw_error("Invalid string token", tok);
@@ -50,8 +100,8 @@ String realize_string(token tok) {
     char quote = *it;
     ++it;  // Skip the quote
 
-    String ret;
-    bool   escaped = false;
+    ret.clear();
+    bool escaped = false;
     for (; it != stop; ++it) {
         char c = *it;
         if (escaped) {
@@ -67,6 +117,12 @@ String realize_string(token tok) {
             case 'r':
                 ret.push_back('\r');
                 break;
+            case '\r':
+                // An escaped CRLF is ignored as a whole
+                if (std::next(it) != stop && *std::next(it) == '\n') {
+                    ++it;
+                }
+                break;
             case '\n':
                 // An escaped newline: Just ignore it like it doesn't exist
                 break;
@@ -85,40 +141,80 @@ String realize_string(token tok) {
     if (it == stop || (std::next(it) != stop)) {
         throw_error("Invalid string token", tok);
     }
-    return ret;
+}
+
+template <typename String>
+String realize_string(token tok) {
+    if constexpr (requires(String str) { str.push_back('\0'); }) {
+        String ret;
+        realize_string_into(tok, ret);
+        return ret;
+    } else {
+        // An immutable string type: Build the content first, then convert it
+        std::string tmp;
+        realize_string_into(tok, tmp);
+        return String(std::move(tmp));
+    }
+}
+
+/**
+ * Obtain the key of an object member from its key token. The key and `member_size` bytes for
+ * the member itself are charged against the allocation limit, and counted in the statistics.
+ * This is shared by every builder of object data, so that they all agree on the charges.
+ */
+template <typename Key>
+Key realize_member_key(parser& p, const token& key_tok, std::size_t member_size) {
+    charge_allocation(p, member_size + key_tok.spelling.size(), key_tok);
+    update_stats(p.options(), [](parse_stats& stats) { ++stats.allocations; });
+    if (key_tok.kind == token::identifier) {
+        return Key(key_tok.spelling);
+    } else if (key_tok.kind == token::string_literal) {
+        update_stats(p.options(), [](parse_stats& stats) { ++stats.strings_unescaped; });
+        return realize_string<Key>(key_tok);
+    } else {
+        throw_error("Invalid object member key token", key_tok);
+    }
 }
 
 template <typename Data, typename ArrayType = typename Data::array_type>
-ArrayType parse_array_inner(json5::parser& p) {
-    ArrayType ret;
+ArrayType parse_array_inner(json5::parser& p, size_hints* hints = nullptr) {
+    update_stats(p.options(), [](parse_stats& stats) { ++stats.allocations; });
+    ArrayType   ret;
+    std::size_t reserved = 0;
+    if (hints) {
+        reserved = reserve_charged(p, ret, hints->take());
+    }
     for (auto ev = p.next(); ev.kind != ev.array_end; ev = p.next()) {
-        ret.push_back(parse_inner<Data>(p, ev));
+        if (ret.size() >= reserved) {
+            charge_allocation(p, sizeof(typename ArrayType::value_type), ev.token);
+        }
+        ret.push_back(parse_inner<Data>(p, ev, hints));
     }
     return ret;
 }
 
 template <typename Data, typename ObjectType = typename Data::mapping_type>
-ObjectType parse_object_inner(json5::parser& p) {
+ObjectType parse_object_inner(json5::parser& p, size_hints* hints = nullptr) {
+    update_stats(p.options(), [](parse_stats& stats) { ++stats.allocations; });
     ObjectType ret;
     using key_type    = typename ObjectType::key_type;
     using mapped_type = typename ObjectType::mapped_type;
-    for (auto ev = p.next(); ev.kind != ev.object_end; ev = p.next()) {
+    std::size_t reserved = 0;
+    if (hints) {
+        // Always take the hint, even if unused, to stay in step with the pre-pass
+        reserved = reserve_charged(p, ret, hints->take());
+    }
+    std::size_t n = 0;
+    for (auto ev = p.next(); ev.kind != ev.object_end; ev = p.next(), ++n) {
         if (ev.kind != ev.object_key) {
             throw_error(p.error_message(), ev.token);
         }
         // Get that key!
-        key_type    new_key;
-        const auto& key_tok = ev.token;
-        if (key_tok.kind == token::identifier) {
-            new_key = key_type(key_tok.spelling);
-        } else if (key_tok.kind == token::string_literal) {
-            new_key = realize_string<key_type>(key_tok);
-        } else {
-            throw_error("Invalid object member key token", key_tok);
-        }
+        auto new_key = realize_member_key<key_type>(
+            p, ev.token, n < reserved ? 0 : sizeof(typename ObjectType::value_type));
 
         // Get the corresponding value
-        auto new_val = static_cast<mapped_type>(parse_next_value<Data>(p));
+        auto new_val = static_cast<mapped_type>(parse_inner<Data>(p, p.next(), hints));
 
         ret.emplace(std::move(new_key), std::move(new_val));
     }
@@ -126,7 +222,7 @@ ObjectType parse_object_inner(json5::parser& p) {
 }
 
 template <typename Data>
-Data parse_inner(json5::parser& p, const json5::parse_event& ev) {
+Data parse_inner(json5::parser& p, const json5::parse_event& ev, size_hints* hints) {
     using string_type  = typename Data::string_type;
     using number_type  = typename Data::number_type;
     using null_type    = typename Data::null_type;
@@ -135,10 +231,16 @@ Data parse_inner(json5::parser& p, const json5::parse_event& ev) {
     using pek = parse_event::kind_t;
     switch (ev.kind) {
     case pek::number_literal:
+        update_stats(p.options(), [](parse_stats& stats) { ++stats.numbers_parsed; });
         return realize_number<number_type>(ev.token);
     case pek::boolean_literal:
         return realize_boolean<boolean_type>(ev.token);
     case pek::string_literal:
+        update_stats(p.options(), [](parse_stats& stats) {
+            ++stats.strings_unescaped;
+            ++stats.allocations;
+        });
+        charge_allocation(p, ev.token.spelling.size(), ev.token);
         return realize_string<string_type>(ev.token);
     case pek::null_literal:
         return null_type();
@@ -147,9 +249,9 @@ Data parse_inner(json5::parser& p, const json5::parse_event& ev) {
     case pek::eof:
         throw_error("Unexpected end-of-input", ev.token);
     case pek::array_begin:
-        return parse_array_inner<Data>(p);
+        return parse_array_inner<Data>(p, hints);
     case pek::object_begin:
-        return parse_object_inner<Data>(p);
+        return parse_object_inner<Data>(p, hints);
     default:
         throw_error("Invalid parse event sequence", ev.token);
     }
@@ -157,6 +259,37 @@ Data parse_inner(json5::parser& p, const json5::parse_event& ev) {
 
 }  // namespace detail
 
+namespace detail {
+
+/**
+ * Parse the entirety of `str`, which the parser must have been given, as a single value.
+ * The size hints are replaced.
+ */
+template <typename Data>
+Data parse_document(json5::parser& p, std::string_view str, size_hints& hints) {
+    hints.next         = 0;
+    const auto& limits = p.options().limits;
+    // Don't scan an input that the parser is going to reject. The hints may take up no more
+    // memory than the document itself is allowed, or pre-sizing is skipped.
+    if (p.options().presize_containers == toggle::on && str.size() <= limits.max_bytes) {
+        // Reuses the storage of the previous document's hints
+        const auto max_hints = p.allocation_budget() / sizeof(std::size_t);
+        if (!count_container_sizes(str, hints.sizes, max_hints)) {
+            hints.sizes.clear();
+        }
+    } else {
+        hints.sizes.clear();
+    }
+    auto v      = parse_inner<Data>(p, p.next(), &hints);
+    auto eof_ev = p.next();
+    if (eof_ev.kind != eof_ev.eof) {
+        throw_error("Trailing characters in JSON data", eof_ev.token);
+    }
+    return v;
+}
+
+}  // namespace detail
+
 template <typename Data>
 Data parse_next_value(parser& p) {
     return detail::parse_inner<Data>(p, p.next());
@@ -164,18 +297,14 @@ Data parse_next_value(parser& p) {
 
 template <typename Data = data>
 Data parse_data(std::string_view str, parse_options opts) {
-    parser p{str, opts};
-    auto   v      = parse_next_value<Data>(p);
-    auto   eof_ev = p.next();
-    if (eof_ev.kind != eof_ev.eof) {
-        detail::throw_error("Trailing characters in JSON data", eof_ev.token);
-    }
-    return v;
+    parser             p{str, opts};
+    detail::size_hints hints;
+    return detail::parse_document<Data>(p, str, hints);
 }
 
 template <typename Data = data>
 Data parse_data(std::string_view str) {
-    return parse_data(str, parse_options{});
+    return parse_data<Data>(str, parse_options{});
 }
 
 }  // namespace json5
@@ -2,6 +2,8 @@
 
 #include <catch2/catch.hpp>
 
+#include <string>
+
 TEST_CASE("Parse simple values") {
     auto v = json5::parse_data("5");
     CHECK(v == 5);
@@ -20,6 +22,9 @@ TEST_CASE("Parse simple values") {
 
     v = json5::parse_data("\"String with \\\"quotes\\\"\"");
     CHECK(v.as_string() == "String with \"quotes\"");
+
+    v = json5::parse_data("'line \\\r\ncontinued'");
+    CHECK(v == "line continued");
 }
 
 TEST_CASE("Parse arrays") {
@@ -49,4 +54,114 @@ TEST_CASE("Parse objects") {
 
     v = json5::parse_data("{foo: 'bar'}");
     CHECK(v == json5::data::object_type({{"foo", "bar"}}));
-}
\ No newline at end of file
+
+    v = json5::parse_data("{ünïcödé: 'ßnow ☃', Ωmega_2: 1}");
+    CHECK(v == json5::data::object_type({{"ünïcödé", "ßnow ☃"}, {"Ωmega_2", 1}}));
+}
+
+TEST_CASE("Count container sizes") {
+    std::vector<std::size_t> sizes = {7, 7};
+    json5::detail::count_container_sizes(
+        "{a: [1, 2, [], ['x,]', /* , */ 3,],], b: {}, c: {d: 'e'}}", sizes);
+    CHECK(sizes == std::vector<std::size_t>{3, 4, 0, 2, 0, 1});
+
+    CHECK_FALSE(json5::detail::count_container_sizes("[[], [[]], []]", sizes, 3));
+    CHECK(sizes.size() == 3);
+}
+
+TEST_CASE("Parse with pre-sized containers") {
+    json5::parse_options opts = json5::json5_options;
+    opts.presize_containers   = json5::toggle::on;
+
+    std::string_view str = "{a: [1, 2, [3, [4, 5]], 'six',], b: [{c: []}]}";
+    auto             v   = json5::parse_data(str, opts);
+    CHECK(v == json5::parse_data(str));
+    CHECK(v.as_object().at("a").as_array().capacity() == 4);
+
+    CHECK_THROWS_AS(json5::parse_data("[1, 2", opts), json5::parse_error);
+}
+
+namespace {
+
+std::string parse_error_message(std::string_view str, json5::parse_limits limits) {
+    json5::parse_options opts = json5::json5_options;
+    opts.limits               = limits;
+    try {
+        json5::parse_data(str, opts);
+        return "";
+    } catch (const json5::parse_error& e) {
+        return e.what();
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Parse with resource limits") {
+    using limits = json5::parse_limits;
+
+    CHECK(parse_error_message("[1, 2, 3]", limits{.max_bytes = 9}) == "");
+    CHECK_THAT(parse_error_message("[1, 2, 3] ", limits{.max_bytes = 9}),
+               Catch::Contains("Input exceeds the size limit"));
+
+    CHECK(parse_error_message("[[[]]]", limits{.max_depth = 3}) == "");
+    CHECK_THAT(parse_error_message("[[[[]]]]", limits{.max_depth = 3}),
+               Catch::Contains("nesting is too deep"));
+
+    CHECK(parse_error_message("{abc: 'abc'}", limits{.max_string_length = 3}) == "");
+    CHECK_THAT(parse_error_message("['abcd']", limits{.max_string_length = 3}),
+               Catch::Contains("String exceeds the length limit"));
+    CHECK_THAT(parse_error_message("{abcd: 1}", limits{.max_string_length = 3}),
+               Catch::Contains("String exceeds the length limit"));
+    CHECK_THAT(parse_error_message("{'abcd': 1}", limits{.max_string_length = 3}),
+               Catch::Contains("String exceeds the length limit"));
+
+    CHECK(parse_error_message("[[1, 2], {a: 1, b: 2}]", limits{.max_elements = 2}) == "");
+    CHECK_THAT(parse_error_message("[1, 2, 3]", limits{.max_elements = 2}),
+               Catch::Contains("Array/object exceeds the element limit"));
+    CHECK_THAT(parse_error_message("[{a: 1, b: 2, c: 3}]", limits{.max_elements = 2}),
+               Catch::Contains("Array/object exceeds the element limit"));
+    // The count of the outer array resumes after the inner ones close
+    CHECK_THAT(parse_error_message("[[1, 2], [3, 4], 5]", limits{.max_elements = 2}),
+               Catch::Contains("Array/object exceeds the element limit"));
+
+    CHECK(parse_error_message("[1, [2], {a: 3}]", limits{.max_nodes = 6}) == "");
+    CHECK_THAT(parse_error_message("[1, [2], {a: 3}, 4]", limits{.max_nodes = 6}),
+               Catch::Contains("Document exceeds the value limit"));
+
+    const auto elem = sizeof(json5::data);
+    CHECK(parse_error_message("[1, 2]", limits{.max_allocated_bytes = 2 * elem}) == "");
+    CHECK_THAT(parse_error_message("[1, 2, 3]", limits{.max_allocated_bytes = 2 * elem}),
+               Catch::Contains("Document exceeds the allocation limit"));
+    CHECK_THAT(parse_error_message("'a long string that is over the limit'",
+                                   limits{.max_allocated_bytes = 16}),
+               Catch::Contains("Document exceeds the allocation limit"));
+
+    // Pre-sizing does not reserve more than the element limit allows
+    json5::parse_options opts = json5::json5_options;
+    opts.presize_containers   = json5::toggle::on;
+    opts.limits.max_elements  = 2;
+    CHECK_THROWS_AS(json5::parse_data("[1, 2, 3]", opts), json5::parse_error);
+
+    // Reserved room is charged against the allocation limit, but only once
+    opts.limits                     = {};
+    opts.limits.max_allocated_bytes = 5 * elem;
+    const auto nested               = json5::parse_data("[[1, 2], [3]]", opts);
+    CHECK(nested.as_array().capacity() == 2);
+    CHECK(nested.as_array()[0].as_array().capacity() == 2);
+    CHECK_THROWS_AS(json5::parse_data("[[1, 2], [3, 4]]", opts), json5::parse_error);
+
+    // The pre-pass does not outgrow the limits either
+    std::string many = "[";
+    for (int i = 0; i < 1000; ++i) {
+        many += "[],";
+    }
+    many += "]";
+    opts.limits           = {};
+    opts.limits.max_bytes = 10;
+    CHECK_THROWS_WITH(json5::parse_data(many, opts),
+                      Catch::Contains("Input exceeds the size limit"));
+    opts.limits                     = {};
+    opts.limits.max_allocated_bytes = 10 * sizeof(std::size_t);
+    CHECK_THROWS_WITH(json5::parse_data(many, opts),
+                      Catch::Contains("Document exceeds the allocation limit"));
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <json5/parse_data.hpp>
+
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace json5 {
+
+namespace detail {
+
+/// Scratch storage that is kept for the duration of a `parse_into`
+template <typename Data>
+struct into_context {
+    typename Data::mapping_type::key_type key;
+};
+
+/// Set `out` to the text of the given key token, reusing its capacity
+template <typename Key>
+void realize_key_into(const parser& p, token key_tok, Key& out) {
+    if (key_tok.kind == token::identifier) {
+        if constexpr (requires { out.assign(key_tok.spelling.data(), key_tok.spelling.size()); }) {
+            out.assign(key_tok.spelling.data(), key_tok.spelling.size());
+        } else {
+            out = Key(key_tok.spelling);
+        }
+    } else if (key_tok.kind == token::string_literal) {
+        update_stats(p.options(), [](parse_stats& stats) { ++stats.strings_unescaped; });
+        realize_string_into(key_tok, out);
+    } else {
+        throw_error("Invalid object member key token", key_tok);
+    }
+}
+
+template <typename Data>
+void parse_into_inner(parser& p, const parse_event& ev, Data& target, into_context<Data>& ctx);
+
+template <typename Data>
+void parse_array_into(parser& p, typename Data::array_type& arr, into_context<Data>& ctx) {
+    std::size_t n = 0;
+    for (auto ev = p.next(); ev.kind != ev.array_end; ev = p.next(), ++n) {
+        charge_allocation(p, sizeof(Data), ev.token);
+        if (n < arr.size()) {
+            parse_into_inner(p, ev, arr[n], ctx);
+        } else {
+            arr.push_back(parse_inner<Data>(p, ev));
+        }
+    }
+    while (arr.size() > n) {
+        arr.pop_back();
+    }
+}
+
+template <typename Data>
+void parse_object_into(parser& p, typename Data::mapping_type& obj, into_context<Data>& ctx) {
+    using object_type = typename Data::mapping_type;
+    using mapped_type = typename object_type::mapped_type;
+    // Move every existing member aside. Members are moved back as their keys reappear, and
+    // the nodes of members that do not reappear are reused for new keys.
+    object_type old;
+    old.swap(obj);
+    for (auto ev = p.next(); ev.kind != ev.object_end; ev = p.next()) {
+        if (ev.kind != ev.object_key) {
+            throw_error(p.error_message(), ev.token);
+        }
+        charge_allocation(p,
+                          sizeof(typename object_type::value_type) + ev.token.spelling.size(),
+                          ev.token);
+        realize_key_into(p, ev.token, ctx.key);
+        const auto value_ev = p.next();
+        auto       found    = old.find(ctx.key);
+        if (found == old.end() && !old.empty()) {
+            found = old.begin();
+        }
+        if (found == old.end()) {
+            update_stats(p.options(), [](parse_stats& stats) { ++stats.allocations; });
+            obj.emplace(ctx.key, static_cast<mapped_type>(parse_inner<Data>(p, value_ev)));
+            continue;
+        }
+        auto node = old.extract(found);
+        if (node.key() != ctx.key) {
+            std::swap(node.key(), ctx.key);
+        }
+        parse_into_inner(p, value_ev, node.mapped(), ctx);
+        // As with parse_data, the first of any duplicate keys is kept
+        obj.insert(std::move(node));
+    }
+}
+
+template <typename Data>
+void parse_into_inner(parser& p, const parse_event& ev, Data& target, into_context<Data>& ctx) {
+    using string_type = typename Data::string_type;
+    using array_type  = typename Data::array_type;
+    using object_type = typename Data::mapping_type;
+
+    using pek = parse_event::kind_t;
+    switch (ev.kind) {
+    case pek::string_literal:
+        if (auto str = target.template try_get<string_type>()) {
+            update_stats(p.options(), [](parse_stats& stats) { ++stats.strings_unescaped; });
+            charge_allocation(p, ev.token.spelling.size(), ev.token);
+            realize_string_into(ev.token, *str);
+            return;
+        }
+        break;
+    case pek::array_begin:
+        if (auto arr = target.template try_get<array_type>()) {
+            parse_array_into(p, *arr, ctx);
+            return;
+        }
+        break;
+    case pek::object_begin:
+        if constexpr (std::is_same_v<typename object_type::mapped_type, Data>  //
+                      && requires(object_type obj) { obj.insert(obj.extract(obj.begin())); }) {
+            if (auto obj = target.template try_get<object_type>()) {
+                parse_object_into(p, *obj, ctx);
+                return;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    // The shape differs from the existing value, or there is no storage worth keeping
+    target = parse_inner<Data>(p, ev);
+}
+
+}  // namespace detail
+
+/**
+ * Parse a document into an existing value, reusing its storage wherever the new document
+ * has the same shape: Strings are unescaped into their existing capacity, array elements are
+ * parsed in place, and object members are parsed into the map nodes of members with the
+ * same key. Map nodes left over from removed keys are reused for new keys. Values whose
+ * type differs are replaced.
+ *
+ * When the same `target` is used repeatedly for documents of a similar shape, as with
+ * reading a stream of records or re-reading a configuration file, this approaches zero
+ * allocations per parse.
+ *
+ * If an exception is thrown, `target` is left in a valid but unspecified state.
+ */
+template <typename Data>
+void parse_into(Data& target, std::string_view str, parse_options opts) {
+    parser                     p{str, opts};
+    detail::into_context<Data> ctx;
+    detail::parse_into_inner(p, p.next(), target, ctx);
+    auto eof_ev = p.next();
+    if (eof_ev.kind != eof_ev.eof) {
+        detail::throw_error("Trailing characters in JSON data", eof_ev.token);
+    }
+}
+
+template <typename Data>
+void parse_into(Data& target, std::string_view str) {
+    parse_into(target, str, parse_options{});
+}
+
+}  // namespace json5
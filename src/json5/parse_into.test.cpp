@@ -0,0 +1,59 @@
+#include <json5/parse_into.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+TEST_CASE("Parse into an existing value") {
+    auto doc = GENERATE(as<std::string>{},
+                        "null",
+                        "'string'",
+                        "[1, 2, [3, 4]]",
+                        "{a: 1, b: [true, false], c: {d: 'e'}}",
+                        "{a: 'changed', b: [], c: null, f: 12}",
+                        "[{a: 1}, {b: 2}, 'x']",
+                        "{a: 1, a: 2}");
+    auto prev = GENERATE(as<std::string>{},
+                         "null",
+                         "'a long string that will not fit in the small buffer'",
+                         "[1, 2, 3, 4, 5, 6]",
+                         "{a: 2, b: [1], c: {d: 'f', g: 'h'}, z: true}",
+                         "[{b: 2}, {a: 1}]");
+    CAPTURE(doc, prev);
+    auto target = json5::parse_data(prev);
+    json5::parse_into(target, doc);
+    CHECK(target == json5::parse_data(doc));
+}
+
+TEST_CASE("Parse into reuses storage") {
+    json5::data target = json5::parse_data(
+        "{name: 'a string that is longer than the small string buffer', items: [1, 2, 3]}");
+    auto& obj = target.as_object();
+
+    const auto* name_val  = &obj.at("name");
+    const auto* name_buf  = name_val->as_string().data();
+    const auto* items_buf = obj.at("items").as_array().data();
+
+    json5::parse_into(target,
+                      "{name: 'another long string that is still not longer', items: [4, 5]}");
+    REQUIRE(target.is_object());
+    CHECK(&obj.at("name") == name_val);
+    CHECK(obj.at("name").as_string().data() == name_buf);
+    CHECK(obj.at("name").as_string() == "another long string that is still not longer");
+    CHECK(obj.at("items").as_array().data() == items_buf);
+    CHECK(obj.at("items") == json5::parse_data("[4, 5]"));
+
+    // A renamed key takes over a leftover node
+    json5::parse_into(target, "{items: [], title: 'short'}");
+    CHECK(&obj.at("title") == name_val);
+    CHECK(obj.count("name") == 0);
+    CHECK(target == json5::parse_data("{title: 'short', items: []}"));
+}
+
+TEST_CASE("Parse into reports errors") {
+    json5::data target = json5::parse_data("[1, 2]");
+    CHECK_THROWS_AS(json5::parse_into(target, "[1, 2"), json5::parse_error);
+    CHECK_THROWS_AS(json5::parse_into(target, "[1] 2"), json5::parse_error);
+    json5::parse_into(target, "[3]");
+    CHECK(target == json5::parse_data("[3]"));
+}
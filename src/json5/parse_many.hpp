@@ -0,0 +1,100 @@
+#pragma once
+
+#include <json5/parse_data.hpp>
+#include <json5/thread_group.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace json5 {
+
+/**
+ * The outcome of parsing one document of a batch. If `ok` is false, then `value` is null
+ * and `error` holds the message of the error that was thrown.
+ */
+template <typename Data = data>
+struct parse_result {
+    bool        ok = false;
+    Data        value;
+    std::string error;
+
+    explicit operator bool() const noexcept { return ok; }
+};
+
+/**
+ * Parse each of a batch of documents, spread over `n_threads` threads. If `n_threads` is
+ * zero, the hardware concurrency is used. `inputs` may be any sized range of values that
+ * convert to `std::string_view`. The results are in the same order as the inputs.
+ *
+ * This is intended for large numbers of small documents. Each thread reuses a single
+ * parser and its scratch buffers for all of the documents that it parses, and threads
+ * claim documents in small batches so that uneven sizes are balanced between them.
+ */
+template <typename Data = data, typename Range>
+std::vector<parse_result<Data>>
+parse_many(const Range& inputs, parse_options opts, unsigned n_threads = 0) {
+    std::vector<std::string_view> docs;
+    docs.reserve(static_cast<std::size_t>(std::size(inputs)));
+    for (const auto& input : inputs) {
+        docs.emplace_back(input);
+    }
+
+    constexpr std::size_t batch_size = 16;
+    const auto            n_batches  = (docs.size() + batch_size - 1) / batch_size;
+    if (n_threads == 0) {
+        n_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    n_threads = static_cast<unsigned>(std::min<std::size_t>(n_threads, n_batches));
+
+    std::vector<parse_result<Data>> results(docs.size());
+    std::atomic<std::size_t>        next_batch{0};
+
+    // Each thread keeps its own statistics
+    std::vector<parse_stats> worker_stats(std::max(1u, n_threads));
+    auto                     work = [&](unsigned worker) {
+        auto worker_opts  = opts;
+        worker_opts.stats = opts.stats ? &worker_stats[worker] : nullptr;
+        parser             p{std::string_view(), worker_opts};
+        detail::size_hints hints;
+        for (auto batch = next_batch++; batch < n_batches; batch = next_batch++) {
+            const auto last = std::min(docs.size(), (batch + 1) * batch_size);
+            for (auto idx = batch * batch_size; idx != last; ++idx) {
+                auto& res = results[idx];
+                p.reset(docs[idx]);
+                try {
+                    res.value = detail::parse_document<Data>(p, docs[idx], hints);
+                    res.ok    = true;
+                } catch (const std::exception& e) {
+                    res.error = e.what();
+                }
+            }
+        }
+    };
+
+    detail::thread_group threads;
+    for (unsigned n = 1; n < n_threads; ++n) {
+        threads.spawn(work, n);
+    }
+    work(0u);
+    threads.join();
+
+    detail::update_stats(opts, [&](parse_stats& stats) {
+        for (auto& s : worker_stats) {
+            stats.merge(s);
+        }
+    });
+    return results;
+}
+
+template <typename Data = data, typename Range>
+std::vector<parse_result<Data>> parse_many(const Range& inputs) {
+    return parse_many<Data>(inputs, parse_options{});
+}
+
+}  // namespace json5
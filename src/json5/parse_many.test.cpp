@@ -0,0 +1,48 @@
+#include <json5/parse_many.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+TEST_CASE("Parse many documents") {
+    std::vector<std::string> inputs;
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 97 == 0) {
+            inputs.push_back("{name: 'broken', version: ");
+        } else {
+            inputs.push_back("{name: 'pkg-" + std::to_string(i) + "', version: " + std::to_string(i)
+                             + ", deps: ['a', 'b']}");
+        }
+    }
+    auto threads = GENERATE(0u, 1u, 3u);
+    auto results = json5::parse_many(inputs, json5::json5_options, threads);
+    REQUIRE(results.size() == inputs.size());
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& res = results[i];
+        if (i % 97 == 0) {
+            CHECK_FALSE(res);
+            CHECK(res.value.is_null());
+            CHECK(res.error.find("Unexpected end-of-input") != std::string::npos);
+        } else {
+            REQUIRE(res);
+            CHECK(res.value == json5::parse_data(inputs[i]));
+        }
+    }
+}
+
+TEST_CASE("Parse many with options") {
+    const char* inputs[] = {"[1, 2,]", "// comment\n{\"a\": 1}", "[1, 2]"};
+    auto        results  = json5::parse_many(inputs, json5::jsonc_options);
+    CHECK_FALSE(results[0]);
+    CHECK(results[1]);
+    CHECK(results[2]);
+
+    json5::parse_options presize = json5::json5_options;
+    presize.presize_containers   = json5::toggle::on;
+    auto sized                   = json5::parse_many(inputs, presize, 2);
+    CHECK(sized[0].value == json5::parse_data("[1, 2]"));
+    CHECK(sized[2].value == json5::parse_data("[1, 2]"));
+
+    CHECK(json5::parse_many(std::vector<std::string_view>{}).empty());
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <json5/parse_data.hpp>
+#include <json5/structure.hpp>
+#include <json5/thread_group.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace json5 {
+
+/**
+ * Parse a document, using multiple threads to construct the elements of a top-level
+ * array in parallel. Documents of any other shape are parsed serially, as are any
+ * documents that contain errors (so that the error matches that of `parse_data()`). So are
+ * documents parsed with limits on the number of elements, values, or allocated bytes, as
+ * those apply to the document as a whole.
+ *
+ * If `n_threads` is zero, the hardware concurrency is used.
+ */
+template <typename Data = data>
+Data parse_data_parallel(std::string_view str, parse_options opts, unsigned n_threads = 0) {
+    if (n_threads == 0) {
+        n_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // Limits on the document as a whole are only checked by a serial parse
+    const auto& limits = opts.limits;
+    if (n_threads == 1 || str.size() > limits.max_bytes || limits.max_depth == 0
+        || limits.max_elements != SIZE_MAX || limits.max_nodes != SIZE_MAX
+        || limits.max_allocated_bytes != SIZE_MAX) {
+        return parse_data<Data>(str, opts);
+    }
+    auto ranges = detail::split_toplevel_array(str, opts);
+    if (!ranges || ranges->size() < 2 * n_threads) {
+        return parse_data<Data>(str, opts);
+    }
+
+    // Each element is nested one level within the top-level array
+    auto elem_opts             = opts;
+    elem_opts.limits.max_depth = std::min<std::size_t>(limits.max_depth, 1024) - 1;
+
+    const auto        n_elems = ranges->size();
+    std::vector<Data> elems(n_elems);
+    std::atomic<bool> failed{false};
+
+    // Each thread takes a contiguous block of elements, and keeps its own statistics
+    const auto               block_size = (n_elems + n_threads - 1) / n_threads;
+    std::vector<parse_stats> block_stats((n_elems + block_size - 1) / block_size);
+    auto parse_block = [&](std::size_t first, std::size_t last) {
+        auto block_opts  = elem_opts;
+        block_opts.stats = opts.stats ? &block_stats[first / block_size] : nullptr;
+        try {
+            for (auto idx = first; idx != last && !failed.load(std::memory_order_relaxed);
+                 ++idx) {
+                elems[idx] = parse_data<Data>((*ranges)[idx], block_opts);
+            }
+        } catch (...) {
+            failed = true;
+        }
+    };
+
+    detail::thread_group threads;
+    for (std::size_t first = block_size; first < n_elems; first += block_size) {
+        threads.spawn(parse_block, first, std::min(first + block_size, n_elems));
+    }
+    parse_block(0, std::min(block_size, n_elems));
+    threads.join();
+
+    if (failed) {
+        // Reparse serially to generate the correct error for the document
+        return parse_data<Data>(str, opts);
+    }
+
+    detail::update_stats(opts, [&](parse_stats& stats) {
+        for (auto& s : block_stats) {
+            // The elements are nested within the top-level array
+            ++s.max_depth;
+            stats.merge(s);
+        }
+        ++stats.allocations;
+    });
+
+    using array_type = typename Data::array_type;
+    if constexpr (std::is_same_v<array_type, std::vector<Data>>) {
+        return array_type(std::move(elems));
+    } else {
+        array_type ret;
+        if constexpr (requires { ret.reserve(n_elems); }) {
+            ret.reserve(n_elems);
+        }
+        for (auto& elem : elems) {
+            ret.push_back(std::move(elem));
+        }
+        return ret;
+    }
+}
+
+template <typename Data = data>
+Data parse_data_parallel(std::string_view str) {
+    return parse_data_parallel<Data>(str, parse_options{});
+}
+
+}  // namespace json5
@@ -0,0 +1,82 @@
+#include <json5/parse_parallel.hpp>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Split a top-level array") {
+    auto ranges = json5::detail::split_toplevel_array(
+        " /* c */ [1, 'a,]', {b: [2, 3]}, // trailing\n ] ",
+        json5::json5_options);
+    REQUIRE(ranges);
+    CHECK(*ranges == std::vector<std::string_view>{"1", "'a,]'", "{b: [2, 3]}"});
+
+    CHECK_FALSE(json5::detail::split_toplevel_array("{a: 1}", json5::json5_options));
+    CHECK_FALSE(json5::detail::split_toplevel_array("[1, , 2]", json5::json5_options));
+    CHECK_FALSE(json5::detail::split_toplevel_array("[1, 2,]", json5::jsonc_options));
+    CHECK_FALSE(json5::detail::split_toplevel_array("[1, 2] 3", json5::json5_options));
+    CHECK_FALSE(json5::detail::split_toplevel_array("[1, 'two]", json5::json5_options));
+}
+
+TEST_CASE("Parse a large array in parallel") {
+    std::string str = "[";
+    for (int i = 0; i < 1000; ++i) {
+        str += "{id: " + std::to_string(i) + ", tags: ['a', 'b'], },\n";
+    }
+    str += "]";
+
+    auto par = json5::parse_data_parallel(str, json5::json5_options, 4);
+    CHECK(par == json5::parse_data(str));
+    REQUIRE(par.as_array().size() == 1000);
+    CHECK(par.as_array()[999].as_object().at("id") == 999);
+
+    // Small and non-array documents are parsed serially
+    CHECK(json5::parse_data_parallel("[1, 2]") == json5::data::array_type({1, 2}));
+    CHECK(json5::parse_data_parallel("{a: 1}") == json5::data::object_type({{"a", 1}}));
+}
+
+TEST_CASE("Parallel parse errors match serial errors") {
+    std::string str = "[";
+    for (int i = 0; i < 100; ++i) {
+        str += i == 70 ? "{id: }," : "{id: 1},";
+    }
+    str += "]";
+
+    std::string serial_error;
+    try {
+        json5::parse_data(str);
+    } catch (const json5::parse_error& e) {
+        serial_error = e.what();
+    }
+    REQUIRE_FALSE(serial_error.empty());
+    CHECK_THROWS_WITH(json5::parse_data_parallel(str, json5::json5_options, 4), serial_error);
+}
+
+TEST_CASE("Parallel parsing applies resource limits") {
+    std::string str = "[";
+    for (int i = 0; i < 100; ++i) {
+        str += "[[" + std::to_string(i) + "]],";
+    }
+    str += "]";
+
+    auto check_same = [&](json5::parse_limits limits) {
+        json5::parse_options opts = json5::json5_options;
+        opts.limits               = limits;
+        std::string serial_error;
+        try {
+            json5::parse_data(str, opts);
+        } catch (const json5::parse_error& e) {
+            serial_error = e.what();
+        }
+        if (serial_error.empty()) {
+            CHECK(json5::parse_data_parallel(str, opts, 4) == json5::parse_data(str, opts));
+        } else {
+            CHECK_THROWS_WITH(json5::parse_data_parallel(str, opts, 4), serial_error);
+        }
+    };
+    check_same({.max_elements = 2});
+    check_same({.max_nodes = 300});
+    check_same({.max_allocated_bytes = 100 * sizeof(json5::data)});
+    check_same({.max_depth = 2});
+    check_same({.max_depth = 3});
+    check_same({.max_bytes = str.size() - 1});
+    check_same({.max_string_length = 1});
+}
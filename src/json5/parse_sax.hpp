@@ -0,0 +1,144 @@
+#pragma once
+
+#include <json5/parse.hpp>
+#include <json5/parse_data.hpp>
+
+#include <string_view>
+#include <type_traits>
+
+namespace json5 {
+
+namespace detail {
+
+/// Invoke a handler callback. Returns `false` if the callback returned `false` to stop.
+template <typename Fn>
+constexpr bool sax_call(Fn&& fn) {
+    if constexpr (std::is_void_v<decltype(fn())>) {
+        fn();
+        return true;
+    } else {
+        return static_cast<bool>(fn());
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Unescape the raw spelling of a string literal or object key, as given to a SAX handler,
+ * into `out`. The existing capacity of `out` is reused. A bare identifier key is copied as-is.
+ */
+template <typename String>
+void unescape_into(std::string_view raw, String& out) {
+    if (raw.empty() || (raw.front() != '"' && raw.front() != '\'')) {
+        out.clear();
+        out.append(raw.data(), raw.size());
+        return;
+    }
+    detail::realize_string_into(token{raw, 0, 0, token::string_literal}, out);
+}
+
+/**
+ * Parse a document and push each of its values to `handler`. The handler may provide any of
+ * the following member functions. Those that are missing are skipped, and those that are
+ * present are called directly, so that they can be inlined into the parse loop:
+ *
+ *  - `on_null()`
+ *  - `on_boolean(bool)`
+ *  - `on_number(std::string_view raw)`
+ *  - `on_string(std::string_view raw)`
+ *  - `on_array_begin()` and `on_array_end()`
+ *  - `on_object_begin()`, `on_key(std::string_view raw)`, and `on_object_end()`
+ *
+ * The `raw` strings are the literals exactly as they appear in the input, including the
+ * quotes of strings and keys. Use `unescape_into()` to obtain their values. They view into
+ * `str`, and so remain valid for as long as it does.
+ *
+ * A callback may return `bool` instead of `void`. If it returns `false`, parsing stops and
+ * `parse_sax` returns `false`. Otherwise, the entire document is parsed and `true` is
+ * returned. A `parse_error` is thrown if the document is invalid, after the callbacks for
+ * everything before the error have been made.
+ */
+template <typename Handler>
+bool parse_sax(std::string_view str, parse_options opts, Handler& handler) {
+    using pek = parse_event::kind_t;
+    parser      p{str, opts};
+    std::size_t depth = 0;
+    do {
+        const auto ev  = p.next();
+        const auto raw = ev.token.spelling;
+        bool       go  = true;
+        switch (ev.kind) {
+        case pek::invalid:
+            detail::throw_error(p.error_message(), ev.token);
+        case pek::eof:
+            detail::throw_error("Unexpected end-of-input", ev.token);
+        case pek::null_literal:
+            if constexpr (requires { handler.on_null(); }) {
+                go = detail::sax_call([&] { return handler.on_null(); });
+            }
+            break;
+        case pek::boolean_literal:
+            if constexpr (requires { handler.on_boolean(true); }) {
+                go = detail::sax_call([&] { return handler.on_boolean(raw == "true"); });
+            }
+            break;
+        case pek::number_literal:
+            if constexpr (requires { handler.on_number(raw); }) {
+                go = detail::sax_call([&] { return handler.on_number(raw); });
+            }
+            break;
+        case pek::string_literal:
+            if constexpr (requires { handler.on_string(raw); }) {
+                go = detail::sax_call([&] { return handler.on_string(raw); });
+            }
+            break;
+        case pek::array_begin:
+            ++depth;
+            if constexpr (requires { handler.on_array_begin(); }) {
+                go = detail::sax_call([&] { return handler.on_array_begin(); });
+            }
+            break;
+        case pek::array_end:
+            --depth;
+            if constexpr (requires { handler.on_array_end(); }) {
+                go = detail::sax_call([&] { return handler.on_array_end(); });
+            }
+            break;
+        case pek::object_begin:
+            ++depth;
+            if constexpr (requires { handler.on_object_begin(); }) {
+                go = detail::sax_call([&] { return handler.on_object_begin(); });
+            }
+            break;
+        case pek::object_key:
+            if constexpr (requires { handler.on_key(raw); }) {
+                go = detail::sax_call([&] { return handler.on_key(raw); });
+            }
+            break;
+        case pek::object_end:
+            --depth;
+            if constexpr (requires { handler.on_object_end(); }) {
+                go = detail::sax_call([&] { return handler.on_object_end(); });
+            }
+            break;
+        case pek::comment:
+            break;
+        }
+        if (!go) {
+            return false;
+        }
+    } while (depth != 0);
+
+    auto eof_ev = p.next();
+    if (eof_ev.kind != eof_ev.eof) {
+        detail::throw_error("Trailing characters in JSON data", eof_ev.token);
+    }
+    return true;
+}
+
+template <typename Handler>
+bool parse_sax(std::string_view str, Handler& handler) {
+    return parse_sax(str, parse_options{}, handler);
+}
+
+}  // namespace json5
@@ -0,0 +1,88 @@
+#include <json5/parse_sax.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Records every callback as a line of text
+struct recorder {
+    std::vector<std::string> events;
+
+    void on_null() { events.push_back("null"); }
+    void on_boolean(bool b) { events.push_back(b ? "true" : "false"); }
+    void on_number(std::string_view raw) { events.push_back("num " + std::string(raw)); }
+    void on_string(std::string_view raw) {
+        std::string str;
+        json5::unescape_into(raw, str);
+        events.push_back("str " + str);
+    }
+    void on_array_begin() { events.push_back("["); }
+    void on_array_end() { events.push_back("]"); }
+    void on_object_begin() { events.push_back("{"); }
+    void on_key(std::string_view raw) {
+        std::string key;
+        json5::unescape_into(raw, key);
+        events.push_back("key " + key);
+    }
+    void on_object_end() { events.push_back("}"); }
+};
+
+/// Only counts numbers, and stops after the given number of them
+struct number_counter {
+    int limit = 0;
+    int count = 0;
+
+    bool on_number(std::string_view) { return ++count < limit; }
+};
+
+}  // namespace
+
+TEST_CASE("SAX events") {
+    recorder rec;
+    CHECK(json5::parse_sax("{a: [1, 'two\\n', null], \"b\\\\\": {c: true}, d: false} // done",
+                           rec));
+    CHECK(rec.events
+          == std::vector<std::string>{
+              "{",
+              "key a",
+              "[",
+              "num 1",
+              "str two\n",
+              "null",
+              "]",
+              "key b\\",
+              "{",
+              "key c",
+              "true",
+              "}",
+              "key d",
+              "false",
+              "}",
+          });
+
+    rec.events.clear();
+    CHECK(json5::parse_sax("'scalar'", rec));
+    CHECK(rec.events == std::vector<std::string>{"str scalar"});
+}
+
+TEST_CASE("SAX handlers may omit callbacks and stop early") {
+    number_counter counter{100};
+    CHECK(json5::parse_sax("[1, {a: 2, b: [3, 'x']}, 4]", counter));
+    CHECK(counter.count == 4);
+
+    number_counter stopper{2};
+    CHECK_FALSE(json5::parse_sax("[1, 2, 3, 4, oops", stopper));
+    CHECK(stopper.count == 2);
+}
+
+TEST_CASE("SAX errors") {
+    recorder rec;
+    CHECK_THROWS_AS(json5::parse_sax("[1, 2", rec), json5::parse_error);
+    CHECK(rec.events == std::vector<std::string>{"[", "num 1", "num 2"});
+    CHECK_THROWS_AS(json5::parse_sax("1 2", rec), json5::parse_error);
+    CHECK_THROWS_AS(json5::parse_sax("{'a': 1}", json5::json_strict_options, rec),
+                    json5::parse_error);
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <json5/data.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace json5 {
+
+/**
+ * An index from the JSON Pointer of every value in a document to that value, so that
+ * repeated lookups of deep paths take a single hash probe instead of a chain of map and array
+ * lookups.
+ *
+ * The index is built in full on the first lookup, or by calling `build()`. After that it is
+ * never modified, and may be shared by any number of threads. Building the index is also
+ * safe from multiple threads, as only one of them builds it.
+ *
+ * The document is not copied: It must outlive the index, and must not be modified while the
+ * index is in use. Paths are only found in their canonical form: Array indices are in decimal
+ * without leading zeros, and `~` and `/` within keys are escaped as `~0` and `~1`.
+ */
+template <typename Data = data>
+class path_index {
+    const Data* _root;
+
+    mutable std::once_flag _built;
+    /// The text of every path, end to end. The keys of `_index` are views into this.
+    mutable std::string _paths;
+    mutable std::unordered_map<std::string_view, const Data*> _index;
+
+    using entry = std::pair<std::size_t, const Data*>;
+
+    static void _append_escaped(std::string& out, std::string_view key) {
+        for (auto c : key) {
+            if (c == '~') {
+                out += "~0";
+            } else if (c == '/') {
+                out += "~1";
+            } else {
+                out.push_back(c);
+            }
+        }
+    }
+
+    /// Record `node` at the path in `path`, and then each of its children
+    static void _collect(const Data&         node,
+                         std::string&        path,
+                         std::string&        paths,
+                         std::vector<entry>& entries) {
+        entries.emplace_back(path.size(), &node);
+        paths += path;
+        const auto len = path.size();
+        if (node.is_array()) {
+            std::size_t idx = 0;
+            for (const auto& elem : node.as_array()) {
+                path.push_back('/');
+                path += std::to_string(idx++);
+                _collect(elem, path, paths, entries);
+                path.resize(len);
+            }
+        } else if (node.is_object()) {
+            for (const auto& [key, value] : node.as_object()) {
+                path.push_back('/');
+                _append_escaped(path, std::string_view(key));
+                _collect(value, path, paths, entries);
+                path.resize(len);
+            }
+        }
+    }
+
+    void _build() const {
+        // `call_once` tries again if a previous build threw, so discard what it left behind
+        _paths.clear();
+        _index.clear();
+        std::vector<entry> entries;
+        std::string        path;
+        _collect(*_root, path, _paths, entries);
+        // Only take views into the path text once it has stopped growing
+        _index.reserve(entries.size());
+        std::size_t offset = 0;
+        for (auto [length, node] : entries) {
+            _index.emplace(std::string_view(_paths).substr(offset, length), node);
+            offset += length;
+        }
+    }
+
+public:
+    /// Create an index of the given document. The index is built on first use.
+    explicit path_index(const Data& root) noexcept
+        : _root(&root) {}
+
+    path_index(const path_index&) = delete;
+    path_index& operator=(const path_index&) = delete;
+
+    /// Build the index now, if it has not already been built
+    void build() const {
+        std::call_once(_built, [this] { _build(); });
+    }
+
+    /// Find the value at the given JSON Pointer, or return `nullptr` if there is none
+    const Data* find(std::string_view pointer) const {
+        build();
+        auto found = _index.find(pointer);
+        return found == _index.end() ? nullptr : found->second;
+    }
+
+    bool contains(std::string_view pointer) const { return find(pointer) != nullptr; }
+
+    /// The number of values in the document, including the root
+    std::size_t size() const {
+        build();
+        return _index.size();
+    }
+
+    const Data& root() const noexcept { return *_root; }
+};
+
+}  // namespace json5
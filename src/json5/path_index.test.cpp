@@ -0,0 +1,139 @@
+#include <json5/path_index.hpp>
+
+#include <json5/parse_data.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Path index lookups") {
+    const auto doc = json5::parse_data(R"({
+        routes: [
+            {path: '/a', upstream: {host: 'one', timeout: 5}},
+            {path: '/b', upstream: {host: 'two', timeout: 30}},
+        ],
+        "a/b": {"c~d": true},
+        "": 'empty key',
+    })");
+
+    json5::path_index<> index{doc};
+    CHECK(&index.root() == &doc);
+    CHECK(index.find("") == &doc);
+
+    const auto& routes = doc.as_object().at("routes").as_array();
+    CHECK(index.find("/routes") == &doc.as_object().at("routes"));
+    CHECK(index.find("/routes/1/upstream/timeout")
+          == &routes[1].as_object().at("upstream").as_object().at("timeout"));
+    CHECK(*index.find("/routes/0/upstream/host") == "one");
+    CHECK(*index.find("/a~1b/c~0d") == true);
+    CHECK(*index.find("/") == "empty key");
+
+    CHECK_FALSE(index.contains("/routes/2"));
+    CHECK_FALSE(index.contains("/routes/01"));
+    CHECK_FALSE(index.contains("/a/b"));
+    CHECK_FALSE(index.contains("routes"));
+
+    // The root, two routes with five values each, and four further values
+    CHECK(index.size() == 1 + 1 + 2 * 5 + 3);
+}
+
+TEST_CASE("Path index covers every value") {
+    const auto doc = json5::parse_data(R"({
+        list: [1, [2, [3, {x: 'y'}]], {}, []],
+        nested: {a: {b: {c: null}}},
+    })");
+
+    json5::path_index<> index{doc};
+    index.build();
+    std::size_t n = 0;
+    // Walk the document, checking that each path resolves by the index as it would by hand
+    auto check = [&](auto& self, const json5::data& node, const std::string& path) -> void {
+        ++n;
+        CHECK(index.find(path) == &node);
+        if (node.is_array()) {
+            for (std::size_t i = 0; i < node.as_array().size(); ++i) {
+                self(self, node.as_array()[i], path + "/" + std::to_string(i));
+            }
+        } else if (node.is_object()) {
+            for (const auto& [key, value] : node.as_object()) {
+                self(self, value, path + "/" + key);
+            }
+        }
+    };
+    check(check, doc, "");
+    CHECK(index.size() == n);
+}
+
+TEST_CASE("Path index is shared across threads") {
+    std::string text = "{routes: [";
+    for (int i = 0; i < 1000; ++i) {
+        text += "{upstream: {timeout: " + std::to_string(i) + "}},";
+    }
+    text += "]}";
+    const auto doc = json5::parse_data(text);
+
+    // The index is built by whichever thread looks up first
+    json5::path_index<> index{doc};
+
+    std::vector<std::thread> threads;
+    std::vector<int>         failures(4);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 1000; ++i) {
+                auto found = index.find("/routes/" + std::to_string(i) + "/upstream/timeout");
+                if (!found || *found != i) {
+                    ++failures[static_cast<std::size_t>(t)];
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    CHECK(failures == std::vector<int>(4, 0));
+    CHECK(index.size() == 2 + 1000 * 3);
+}
+
+namespace {
+
+/// An array-only document whose arrays fail to be read once the countdown reaches zero
+struct flaky_node {
+    std::vector<flaky_node> elems;
+
+    static inline int reads_until_failure = 0;
+
+    bool                           is_array() const noexcept { return !elems.empty(); }
+    const std::vector<flaky_node>& as_array() const {
+        if (reads_until_failure != 0 && --reads_until_failure == 0) {
+            throw std::bad_alloc();
+        }
+        return elems;
+    }
+
+    bool is_object() const noexcept { return false; }
+    const std::vector<std::pair<std::string, flaky_node>>& as_object() const {
+        static const std::vector<std::pair<std::string, flaky_node>> none;
+        return none;
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Path index recovers from a failed build") {
+    flaky_node leaf{{}};
+    flaky_node doc{{leaf, flaky_node{{leaf}}}};
+
+    json5::path_index<flaky_node> index{doc};
+    // Fail on reading the inner array, after the paths of the outer elements were recorded
+    flaky_node::reads_until_failure = 2;
+    CHECK_THROWS_AS(index.build(), std::bad_alloc);
+
+    CHECK(index.find("/1/0") == &doc.elems[1].elems[0]);
+    CHECK(index.find("/1") == &doc.elems[1]);
+    CHECK(index.find("") == &doc);
+    CHECK(index.size() == 4);
+}
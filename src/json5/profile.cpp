@@ -0,0 +1,139 @@
+#include "./profile.hpp"
+
+#include <json5/parse_data.hpp>
+
+#if __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define JSON5_HAVE_PERF_EVENT 1
+#else
+#define JSON5_HAVE_PERF_EVENT 0
+#endif
+
+using namespace json5;
+
+namespace {
+
+/**
+ * A set of hardware counters that are started and stopped together around a phase.
+ */
+class perf_counters {
+    constexpr static int n_counters = 4;
+
+    int _fds[n_counters] = {-1, -1, -1, -1};
+
+#if JSON5_HAVE_PERF_EVENT
+    static int _open(std::uint64_t config) noexcept {
+        ::perf_event_attr attr = {};
+        attr.type              = PERF_TYPE_HARDWARE;
+        attr.size              = sizeof attr;
+        attr.config            = config;
+        attr.disabled          = 1;
+        attr.exclude_kernel    = 1;
+        attr.exclude_hv        = 1;
+        return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+    std::optional<std::uint64_t> _read(int idx) const noexcept {
+#if JSON5_HAVE_PERF_EVENT
+        std::uint64_t value = 0;
+        if (_fds[idx] >= 0 && ::read(_fds[idx], &value, sizeof value) == sizeof value) {
+            return value;
+        }
+#else
+        (void)idx;
+#endif
+        return std::nullopt;
+    }
+
+public:
+    perf_counters() noexcept {
+#if JSON5_HAVE_PERF_EVENT
+        _fds[0] = _open(PERF_COUNT_HW_CPU_CYCLES);
+        _fds[1] = _open(PERF_COUNT_HW_INSTRUCTIONS);
+        _fds[2] = _open(PERF_COUNT_HW_BRANCH_MISSES);
+        _fds[3] = _open(PERF_COUNT_HW_CACHE_MISSES);
+#endif
+    }
+
+    ~perf_counters() {
+#if JSON5_HAVE_PERF_EVENT
+        for (int fd : _fds) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+#endif
+    }
+
+    perf_counters(const perf_counters&) = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+
+    void start() noexcept {
+#if JSON5_HAVE_PERF_EVENT
+        for (int fd : _fds) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    void stop(phase_profile& out) noexcept {
+#if JSON5_HAVE_PERF_EVENT
+        for (int fd : _fds) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+#endif
+        out.cycles        = _read(0);
+        out.instructions  = _read(1);
+        out.branch_misses = _read(2);
+        out.cache_misses  = _read(3);
+    }
+};
+
+template <typename Func>
+phase_profile measure(perf_counters& counters, int iterations, Func&& fn) {
+    phase_profile ret;
+    const auto    start = std::chrono::steady_clock::now();
+    counters.start();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    counters.stop(ret);
+    ret.duration = std::chrono::steady_clock::now() - start;
+    return ret;
+}
+
+}  // namespace
+
+parse_profile json5::profile_parse(std::string_view str, parse_options opts, int iterations) {
+    // Parse once up-front so that invalid input is rejected before measuring anything, and so
+    // that the input is warm in the cache for every phase.
+    parse_data(str, opts);
+
+    perf_counters counters;
+    parse_profile ret;
+    ret.bytes      = str.size();
+    ret.iterations = iterations;
+
+    ret.tokenize = measure(counters, iterations, [&] {
+        tokenizer toks{str};
+        for (auto it = toks.begin(); it != toks.end(); ++it) {
+        }
+    });
+    ret.parse = measure(counters, iterations, [&] {
+        parser p{str, opts};
+        while (!p.done()) {
+            p.next();
+        }
+    });
+    ret.build = measure(counters, iterations, [&] { parse_data(str, opts); });
+    return ret;
+}
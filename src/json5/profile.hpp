@@ -0,0 +1,58 @@
+#pragma once
+
+#include <json5/parse.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace json5 {
+
+/**
+ * The measurements of a single phase of parsing. Hardware counters are only available on
+ * Linux, and only if `perf_event_open` is permitted for the process. Otherwise they are
+ * left empty.
+ */
+struct phase_profile {
+    std::chrono::nanoseconds     duration{};
+    std::optional<std::uint64_t> cycles;
+    std::optional<std::uint64_t> instructions;
+    std::optional<std::uint64_t> branch_misses;
+    std::optional<std::uint64_t> cache_misses;
+};
+
+/**
+ * The result of profiling the parsing of a document. Each phase is a separate pass over
+ * the input that includes the work of the phase before it:
+ *
+ *  - `tokenize` runs only the tokenizer.
+ *  - `parse` runs the event parser, which includes tokenizing.
+ *  - `build` runs `parse_data()`, which includes parsing.
+ *
+ * Thus, the cost of a phase alone is the difference between it and the prior phase.
+ * All measurements are totals over every iteration.
+ */
+struct parse_profile {
+    std::size_t   bytes      = 0;
+    int           iterations = 0;
+    phase_profile tokenize;
+    phase_profile parse;
+    phase_profile build;
+
+    /// Compute the cycles-per-byte of the given phase, if cycles were counted
+    std::optional<double> cycles_per_byte(const phase_profile& phase) const noexcept {
+        if (!phase.cycles || bytes == 0) {
+            return std::nullopt;
+        }
+        return double(*phase.cycles) / (double(bytes) * iterations);
+    }
+};
+
+/**
+ * Profile the phases of parsing the given document. Each phase is repeated `iterations`
+ * times. Throws `parse_error` if the document is invalid.
+ */
+parse_profile profile_parse(std::string_view str, parse_options opts, int iterations = 1);
+
+}  // namespace json5
@@ -0,0 +1,18 @@
+#include <json5/profile.hpp>
+
+#include <json5/parse_data.hpp>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Profile parsing phases") {
+    std::string_view doc     = "{name: 'vob-json5', version: [0, 1, 6], debug: true}";
+    auto             profile = json5::profile_parse(doc, json5::json5_options, 10);
+    CHECK(profile.bytes == doc.size());
+    CHECK(profile.iterations == 10);
+    CHECK(profile.build.duration.count() >= 0);
+    if (profile.tokenize.cycles) {
+        CHECK(profile.cycles_per_byte(profile.tokenize) > 0);
+    }
+
+    CHECK_THROWS_AS(json5::profile_parse("{bad", json5::json5_options), json5::parse_error);
+}
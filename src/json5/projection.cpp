@@ -0,0 +1,204 @@
+#include "./projection.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+using namespace json5;
+
+namespace {
+
+/// A trie of pattern segments. Each pattern is a path from the root.
+struct trie_node {
+    std::map<std::string, std::size_t, std::less<>> literal;
+    std::size_t                                     wildcard = SIZE_MAX;
+    bool                                            terminal = false;
+};
+
+/**
+ * Converts the pattern trie, in which a key may match both a literal and a wildcard
+ * segment, into a deterministic automaton. Each automaton state is the set of trie nodes
+ * that can be reached by the same path.
+ */
+struct determinizer {
+    const std::vector<trie_node>&                     trie;
+    std::map<std::vector<std::size_t>, std::uint32_t> known;
+
+    template <typename Node>
+    std::uint32_t build(std::vector<std::size_t> set, std::vector<Node>& out) {
+        std::sort(set.begin(), set.end());
+        set.erase(std::unique(set.begin(), set.end()), set.end());
+        if (set.empty()) {
+            return projection::reject;
+        }
+        if (auto found = known.find(set); found != known.end()) {
+            return found->second;
+        }
+        const auto idx = static_cast<std::uint32_t>(out.size());
+        known.emplace(set, idx);
+        out.emplace_back();
+
+        std::vector<std::size_t> wild_set;
+        for (auto n : set) {
+            if (trie[n].terminal) {
+                // Everything beneath is selected, so there is no need to go further
+                out[idx].selected = true;
+                return idx;
+            }
+            if (trie[n].wildcard != SIZE_MAX) {
+                wild_set.push_back(trie[n].wildcard);
+            }
+        }
+        std::map<std::string, std::vector<std::size_t>, std::less<>> literal_sets;
+        for (auto n : set) {
+            for (const auto& [key, child] : trie[n].literal) {
+                auto& lset = literal_sets[key];
+                if (lset.empty()) {
+                    lset = wild_set;
+                }
+                lset.push_back(child);
+            }
+        }
+        const auto wild_state = build(wild_set, out);
+        out[idx].wildcard     = wild_state;
+        for (auto& [key, lset] : literal_sets) {
+            const auto child = build(std::move(lset), out);
+            out[idx].literal.emplace(key, child);
+        }
+        return idx;
+    }
+};
+
+}  // namespace
+
+std::vector<std::string> detail::split_pointer(std::string_view pointer) {
+    std::vector<std::string> ret;
+    if (pointer.empty()) {
+        return ret;
+    }
+    if (pointer.front() != '/') {
+        throw std::invalid_argument("JSON Pointer '" + std::string(pointer)
+                                    + "' must begin with a `/`");
+    }
+    pointer.remove_prefix(1);
+    while (true) {
+        const auto  end     = pointer.find('/');
+        const auto  segment = pointer.substr(0, end);
+        std::string token;
+        for (std::size_t i = 0; i < segment.size(); ++i) {
+            if (segment[i] != '~') {
+                token.push_back(segment[i]);
+            } else if (i + 1 < segment.size() && segment[i + 1] == '0') {
+                token.push_back('~');
+                ++i;
+            } else if (i + 1 < segment.size() && segment[i + 1] == '1') {
+                token.push_back('/');
+                ++i;
+            } else {
+                throw std::invalid_argument("Invalid `~` escape in JSON Pointer '"
+                                            + std::string(pointer) + "'");
+            }
+        }
+        ret.push_back(std::move(token));
+        if (end == pointer.npos) {
+            break;
+        }
+        pointer.remove_prefix(end + 1);
+    }
+    return ret;
+}
+
+void detail::skip_value(parser& p, const parse_event& ev) {
+    using pek         = parse_event::kind_t;
+    std::size_t depth = 0;
+    for (auto cur = ev;; cur = p.next()) {
+        switch (cur.kind) {
+        case pek::invalid:
+            throw_error(p.error_message(), cur.token);
+        case pek::eof:
+            throw_error("Unexpected end-of-input", cur.token);
+        case pek::array_begin:
+        case pek::object_begin:
+            ++depth;
+            break;
+        case pek::array_end:
+        case pek::object_end:
+            --depth;
+            break;
+        default:
+            break;
+        }
+        if (depth == 0) {
+            return;
+        }
+    }
+}
+
+std::string_view detail::key_text(const token& key_tok, std::string& buf) {
+    const auto spelling = key_tok.spelling;
+    if (key_tok.kind == token::identifier) {
+        return spelling;
+    }
+    if (key_tok.kind != token::string_literal) {
+        throw_error("Invalid object member key token", key_tok);
+    }
+    if (spelling.find('\\') == spelling.npos) {
+        return spelling.substr(1, spelling.size() - 2);
+    }
+    buf = realize_string<std::string>(key_tok);
+    return buf;
+}
+
+projection::projection(std::initializer_list<std::string_view> patterns) {
+    _compile(std::vector<std::string_view>(patterns));
+}
+
+projection::projection(const std::vector<std::string>& patterns) {
+    _compile(std::vector<std::string_view>(patterns.begin(), patterns.end()));
+}
+
+void projection::_compile(const std::vector<std::string_view>& patterns) {
+    std::vector<trie_node> trie(1);
+    for (auto pattern : patterns) {
+        std::size_t node = 0;
+        for (auto& segment : detail::split_pointer(pattern)) {
+            std::size_t next = trie.size();
+            if (segment == "*") {
+                if (trie[node].wildcard == SIZE_MAX) {
+                    trie[node].wildcard = next;
+                    trie.emplace_back();
+                }
+                node = trie[node].wildcard;
+            } else {
+                auto [it, inserted] = trie[node].literal.emplace(std::move(segment), next);
+                node                = it->second;
+                if (inserted) {
+                    trie.emplace_back();
+                }
+            }
+        }
+        trie[node].terminal = true;
+    }
+    determinizer det{trie, {}};
+    _nodes.clear();
+    det.build({0}, _nodes);
+}
+
+projection::state projection::step(state s, std::string_view key) const {
+    const auto& node  = _nodes[s];
+    auto        found = node.literal.find(key);
+    if (found != node.literal.end()) {
+        return found->second;
+    }
+    return node.wildcard;
+}
+
+projection::state projection::step_index(state s, std::size_t index) const {
+    const auto& node = _nodes[s];
+    if (node.literal.empty()) {
+        return node.wildcard;
+    }
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof buf, index);
+    return step(s, std::string_view(buf, static_cast<std::size_t>(res.ptr - buf)));
+}
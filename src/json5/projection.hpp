@@ -0,0 +1,167 @@
+#pragma once
+
+#include <json5/data.hpp>
+#include <json5/parse.hpp>
+#include <json5/parse_data.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json5 {
+
+/**
+ * A compiled set of path patterns that selects which parts of a document to materialize.
+ *
+ * Patterns are JSON Pointers (RFC 6901), such as `/meta/version` or `/items/0/id`. A
+ * segment that is exactly `*` matches any object key or array index. The empty pattern
+ * `""` selects the entire document.
+ *
+ * When parsing with a projection:
+ *
+ *  - A value matched by a pattern is materialized in full, with all of its contents. Patterns
+ *    cannot select only parts of a value that another pattern selects.
+ *  - Arrays and objects along the path to a pattern are kept, with only their matching
+ *    members and elements, even if none of those are present. Array elements that are
+ *    skipped are omitted, so the indices of the remaining elements may differ from the
+ *    source.
+ *  - Everything else is checked for syntax and then discarded without being allocated.
+ */
+class projection {
+public:
+    /// A state in the matching automaton: The set of patterns that may match at a position
+    using state = std::uint32_t;
+
+    constexpr static state root_state = 0;
+    constexpr static state reject     = UINT32_MAX;
+
+private:
+    struct dfa_node {
+        std::map<std::string, state, std::less<>> literal;
+        state                                      wildcard = reject;
+        bool                                       selected = false;
+    };
+    std::vector<dfa_node> _nodes;
+
+    void _compile(const std::vector<std::string_view>& patterns);
+
+public:
+    /// Compile the given patterns. Throws `std::invalid_argument` on a malformed pattern.
+    projection(std::initializer_list<std::string_view> patterns);
+    explicit projection(const std::vector<std::string>& patterns);
+
+    /// The state after descending into the object member with the given key
+    state step(state s, std::string_view key) const;
+    /// The state after descending into the array element with the given index
+    state step_index(state s, std::size_t index) const;
+
+    /// Whether the value at this state is selected in full
+    bool selects_all(state s) const noexcept { return _nodes[s].selected; }
+};
+
+namespace detail {
+
+/// Split a JSON Pointer into its unescaped reference tokens
+std::vector<std::string> split_pointer(std::string_view pointer);
+
+/// Consume the remaining events of the value that begins with the given event
+void skip_value(parser& p, const parse_event& ev);
+
+/// Obtain the text of a key token. Escaped keys are unescaped into `buf`.
+std::string_view key_text(const token& key_tok, std::string& buf);
+
+/**
+ * Parse the value that begins with `ev` as selected by the projection state `s`, into `out`.
+ *
+ * If `s` selects the value in full, the entire value is materialized by `parse_inner()`,
+ * including every nested array and object. Otherwise, an array or object is built with
+ * the elements and members that a pattern continues into, each parsed by this function in
+ * turn, and the others are consumed with `skip_value()`. The container is stored and this
+ * returns `true` even if it ends up empty. A scalar that is not selected in full is
+ * consumed instead; then this returns `false` and `out` is left unmodified.
+ */
+template <typename Data>
+bool parse_projected(parser& p, const parse_event& ev, const projection& proj,
+                     projection::state s, Data& out) {
+    if (proj.selects_all(s)) {
+        out = parse_inner<Data>(p, ev);
+        return true;
+    }
+    using pek = parse_event::kind_t;
+    switch (ev.kind) {
+    case pek::array_begin: {
+        typename Data::array_type arr;
+        std::size_t               index = 0;
+        for (auto elem_ev = p.next(); elem_ev.kind != pek::array_end; elem_ev = p.next()) {
+            const auto elem_state = proj.step_index(s, index++);
+            if (elem_state == projection::reject) {
+                skip_value(p, elem_ev);
+                continue;
+            }
+            charge_allocation(p, sizeof(Data), elem_ev.token);
+            Data elem;
+            if (parse_projected(p, elem_ev, proj, elem_state, elem)) {
+                arr.push_back(std::move(elem));
+            }
+        }
+        out = std::move(arr);
+        return true;
+    }
+    case pek::object_begin: {
+        using object_type = typename Data::mapping_type;
+        using key_type    = typename object_type::key_type;
+        using mapped_type = typename object_type::mapped_type;
+        object_type obj;
+        std::string key_buf;
+        for (auto key_ev = p.next(); key_ev.kind != pek::object_end; key_ev = p.next()) {
+            if (key_ev.kind != pek::object_key) {
+                throw_error(p.error_message(), key_ev.token);
+            }
+            const auto key          = key_text(key_ev.token, key_buf);
+            const auto member_state = proj.step(s, key);
+            const auto value_ev     = p.next();
+            if (member_state == projection::reject) {
+                skip_value(p, value_ev);
+                continue;
+            }
+            charge_allocation(p,
+                              sizeof(typename object_type::value_type) + key.size(),
+                              key_ev.token);
+            Data value;
+            if (parse_projected(p, value_ev, proj, member_state, value)) {
+                obj.emplace(key_type(key), static_cast<mapped_type>(std::move(value)));
+            }
+        }
+        out = std::move(obj);
+        return true;
+    }
+    default:
+        // A scalar that no pattern selects, or an error
+        skip_value(p, ev);
+        return false;
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Parse a document, materializing only the parts of it that are selected by the given
+ * projection. If the document is a scalar that is not selected, the result is null.
+ */
+template <typename Data = data>
+Data parse_data(std::string_view str, parse_options opts, const projection& proj) {
+    parser p{str, opts};
+    Data   ret = typename Data::null_type();
+    detail::parse_projected(p, p.next(), proj, projection::root_state, ret);
+    auto eof_ev = p.next();
+    if (eof_ev.kind != eof_ev.eof) {
+        detail::throw_error("Trailing characters in JSON data", eof_ev.token);
+    }
+    return ret;
+}
+
+}  // namespace json5
@@ -0,0 +1,64 @@
+#include <json5/projection.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+constexpr auto document = R"({
+    meta: {version: 3, author: 'someone'},
+    items: [
+        {id: 1, price: 9.5, description: 'long text', tags: ['a', 'b']},
+        {id: 2, price: 3, description: 'more text'},
+    ],
+    blob: [[1, 2, 3], {x: 'y'}],
+})";
+
+}  // namespace
+
+TEST_CASE("Parse with a projection") {
+    json5::projection proj{"/meta/*", "/items/*/id", "/items/*/price"};
+    auto              v = json5::parse_data(document, json5::json5_options, proj);
+
+    auto expect = json5::parse_data(R"({
+        meta: {version: 3, author: 'someone'},
+        items: [{id: 1, price: 9.5}, {id: 2, price: 3}],
+    })");
+    CHECK(v == expect);
+}
+
+TEST_CASE("Projections merge literal and wildcard segments") {
+    json5::projection proj{"/items/*/id", "/items/0/tags", "/blob/1"};
+    auto              v      = json5::parse_data(document, json5::json5_options, proj);
+    auto              expect = json5::parse_data(R"({
+        items: [{id: 1, tags: ['a', 'b']}, {id: 2}],
+        blob: [{x: 'y'}],
+    })");
+    CHECK(v == expect);
+}
+
+TEST_CASE("Projection edge cases") {
+    // The empty pattern selects everything
+    CHECK(json5::parse_data(document, json5::json5_options, json5::projection{""})
+          == json5::parse_data(document));
+    // Nothing selected
+    CHECK(json5::parse_data("42", json5::json5_options, json5::projection{"/a"}).is_null());
+    // Containers on the path are kept even if nothing within them is present
+    CHECK(json5::parse_data("{a: {b: 1}, c: [2], d: 3}",
+                            json5::json5_options,
+                            json5::projection{"/a/x", "/c/1", "/d/y"})
+          == json5::parse_data("{a: {}, c: []}"));
+    CHECK(json5::parse_data("{'a/b': 1, 'c~d': 2, e: 3}",
+                            json5::json5_options,
+                            json5::projection{"/a~1b", "/c~0d"})
+          == json5::parse_data("{'a/b': 1, 'c~d': 2}"));
+    CHECK(json5::parse_data(R"({"k\"ey": 1})", json5::json5_options, json5::projection{"/k\"ey"})
+          == json5::parse_data(R"({'k"ey': 1})"));
+
+    // Skipped values must still be valid
+    CHECK_THROWS_AS(json5::parse_data("{a: 1, b: [1, }", json5::json5_options, {"/a"}),
+                    json5::parse_error);
+    CHECK_THROWS_AS(json5::parse_data("{a: 1} 2", json5::json5_options, {"/a"}),
+                    json5::parse_error);
+    CHECK_THROWS_AS(json5::projection{"a/b"}, std::invalid_argument);
+    CHECK_THROWS_AS(json5::projection{"/a~2"}, std::invalid_argument);
+}
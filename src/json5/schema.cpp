@@ -0,0 +1,394 @@
+#include "./schema.hpp"
+
+#include <json5/parse_data.hpp>
+#include <json5/projection.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+using namespace json5;
+
+namespace {
+
+std::string format_number(double d) {
+    char buf[32];
+    std::snprintf(buf, sizeof buf, "%g", d);
+    return buf;
+}
+
+unsigned type_bit(parse_event::kind_t kind) noexcept {
+    switch (kind) {
+    case parse_event::null_literal:
+        return schema::type_null;
+    case parse_event::boolean_literal:
+        return schema::type_boolean;
+    case parse_event::number_literal:
+        return schema::type_number;
+    case parse_event::string_literal:
+        return schema::type_string;
+    case parse_event::array_begin:
+        return schema::type_array;
+    case parse_event::object_begin:
+        return schema::type_object;
+    default:
+        return 0;
+    }
+}
+
+std::string type_name(unsigned bit) {
+    switch (bit) {
+    case schema::type_null:
+        return "null";
+    case schema::type_boolean:
+        return "boolean";
+    case schema::type_number:
+        return "number";
+    case schema::type_string:
+        return "string";
+    case schema::type_array:
+        return "array";
+    default:
+        return "object";
+    }
+}
+
+unsigned parse_type_name(const data& name, bool& integer) {
+    if (!name.is_string()) {
+        throw std::invalid_argument("JSON Schema `type` names must be strings");
+    }
+    const auto& str = name.as_string();
+    if (str == "integer") {
+        integer = true;
+        return 0;
+    }
+    for (unsigned bit = 1; bit < schema::type_any; bit <<= 1) {
+        if (str == type_name(bit)) {
+            return bit;
+        }
+    }
+    throw std::invalid_argument("Unknown JSON Schema type '" + str + "'");
+}
+
+/// The number of code points in a UTF-8 string
+std::size_t utf8_length(std::string_view str) noexcept {
+    return static_cast<std::size_t>(std::count_if(str.begin(), str.end(), [](char c) {
+        return (static_cast<unsigned char>(c) & 0xc0) != 0x80;
+    }));
+}
+
+bool has_digits(std::string_view spelling) noexcept {
+    return spelling == "Infinity" || spelling == "NaN"
+        || std::any_of(spelling.begin(), spelling.end(), [](char c) {
+               return c >= '0' && c <= '9';
+           });
+}
+
+/**
+ * Walks the events of a document and checks each against the schema node that applies to
+ * it. The only state is one frame for each open array or object.
+ */
+class schema_walker {
+    struct frame {
+        schema::node_index node;
+        bool               is_object;
+        std::vector<bool>  seen_required;
+        schema::node_index pending = schema::accept_any;
+    };
+
+    const schema&      _schema;
+    std::string_view   _buf;
+    parser             _p;
+    std::vector<frame> _frames;
+    schema_result      _result;
+    std::string        _key_buf;
+
+    std::size_t _offset(const token& tok) const noexcept {
+        const auto ptr = tok.spelling.data();
+        if (std::less<>{}(ptr, _buf.data()) || std::less<>{}(_buf.data() + _buf.size(), ptr)) {
+            // The EOF token does not point into the input
+            return _buf.size();
+        }
+        return static_cast<std::size_t>(ptr - _buf.data());
+    }
+
+    bool _fail(const token& tok, std::string reason) {
+        _result = {false, _offset(tok), std::move(reason)};
+        return false;
+    }
+
+    bool _check_scalar(const schema::node& n, const parse_event& ev) {
+        if (ev.kind == parse_event::number_literal && !has_digits(ev.token.spelling)) {
+            return _fail(ev.token, "Invalid number literal");
+        }
+        const bool constrained = n.enum_values || n.integer_only || n.minimum || n.maximum
+            || n.max_length;
+        if (!constrained) {
+            return true;
+        }
+        data value;
+        if (ev.kind == parse_event::number_literal) {
+            try {
+                value = detail::realize_number<data::number_type>(ev.token);
+            } catch (const std::invalid_argument&) {
+                return _fail(ev.token, "Invalid number literal");
+            } catch (const std::out_of_range&) {
+                return _fail(ev.token, "Number is out of range");
+            }
+        } else {
+            try {
+                value = detail::parse_inner<data>(_p, ev);
+            } catch (const parse_error& e) {
+                // An invalid string, or a resource limit
+                return _fail(ev.token, e.what());
+            }
+        }
+        if (n.enum_values
+            && std::find(n.enum_values->begin(), n.enum_values->end(), value)
+                == n.enum_values->end()) {
+            return _fail(ev.token, "Value is not one of the allowed values");
+        }
+        if (value.is_number()) {
+            const double d = value.as_number();
+            if (n.integer_only && !(std::isfinite(d) && std::trunc(d) == d)) {
+                return _fail(ev.token, "Expected an integer");
+            }
+            if (n.minimum && !(d >= *n.minimum)) {
+                return _fail(ev.token, "Value is less than the minimum of "
+                                 + format_number(*n.minimum));
+            }
+            if (n.maximum && !(d <= *n.maximum)) {
+                return _fail(ev.token, "Value is greater than the maximum of "
+                                 + format_number(*n.maximum));
+            }
+        } else if (value.is_string() && n.max_length
+                   && utf8_length(value.as_string()) > *n.max_length) {
+            return _fail(ev.token, "String is longer than the maximum length of "
+                             + std::to_string(*n.max_length));
+        }
+        return true;
+    }
+
+    /// Check the value that begins with the given event against the given schema node
+    bool _check_value(schema::node_index idx, const parse_event& ev) {
+        const auto& n   = _schema.node_at(idx);
+        const auto  bit = type_bit(ev.kind);
+        if (n.reject_all) {
+            return _fail(ev.token, "Value is not allowed by the schema");
+        }
+        if (!(n.types & bit)) {
+            std::string expected;
+            for (unsigned b = 1; b < schema::type_any; b <<= 1) {
+                if (n.types & b) {
+                    expected += (expected.empty() ? "" : " or ") + type_name(b);
+                }
+            }
+            return _fail(ev.token, "Expected " + expected + ", got " + type_name(bit));
+        }
+        if (ev.kind == parse_event::array_begin || ev.kind == parse_event::object_begin) {
+            if (n.enum_values) {
+                return _fail(ev.token, "Value is not one of the allowed values");
+            }
+            const bool is_object = ev.kind == parse_event::object_begin;
+            _frames.push_back(
+                {idx, is_object, std::vector<bool>(is_object ? n.required.size() : 0)});
+            return true;
+        }
+        return _check_scalar(n, ev);
+    }
+
+    bool _object_key(const parse_event& ev) {
+        auto&       f   = _frames.back();
+        const auto& n   = _schema.node_at(f.node);
+        const auto  key = detail::key_text(ev.token, _key_buf);
+
+        auto found = n.properties.find(key);
+        if (found != n.properties.end()) {
+            f.pending = found->second;
+        } else if (_schema.node_at(n.additional).reject_all) {
+            return _fail(ev.token, "Property '" + std::string(key) + "' is not allowed");
+        } else {
+            f.pending = n.additional;
+        }
+        auto req = std::lower_bound(n.required.begin(), n.required.end(), key);
+        if (req != n.required.end() && *req == key) {
+            f.seen_required[static_cast<std::size_t>(req - n.required.begin())] = true;
+        }
+        return true;
+    }
+
+    bool _close(const parse_event& ev) {
+        const auto& f = _frames.back();
+        if (f.is_object) {
+            const auto& n = _schema.node_at(f.node);
+            for (std::size_t i = 0; i != n.required.size(); ++i) {
+                if (!f.seen_required[i]) {
+                    return _fail(ev.token, "Missing required property '" + n.required[i] + "'");
+                }
+            }
+        }
+        _frames.pop_back();
+        return true;
+    }
+
+public:
+    schema_walker(const schema& s, std::string_view buf, parse_options opts)
+        : _schema(s)
+        , _buf(buf)
+        , _p(buf, opts) {}
+
+    schema_result run() {
+        bool top_done = false;
+        while (true) {
+            const auto ev = _p.next();
+            switch (ev.kind) {
+            case parse_event::invalid:
+                _fail(ev.token, std::string(_p.error_message()));
+                return _result;
+            case parse_event::eof:
+                if (!top_done) {
+                    _fail(ev.token, "Unexpected end-of-input");
+                }
+                return _result;
+            case parse_event::comment:
+                break;
+            case parse_event::object_key:
+                if (!_object_key(ev)) {
+                    return _result;
+                }
+                break;
+            case parse_event::array_end:
+            case parse_event::object_end:
+                if (!_close(ev)) {
+                    return _result;
+                }
+                top_done = _frames.empty();
+                break;
+            default: {
+                if (top_done) {
+                    _fail(ev.token, "Trailing characters in JSON data");
+                    return _result;
+                }
+                schema::node_index idx = _schema.root();
+                if (!_frames.empty()) {
+                    const auto& f = _frames.back();
+                    idx           = f.is_object ? f.pending : _schema.node_at(f.node).items;
+                }
+                if (!_check_value(idx, ev)) {
+                    return _result;
+                }
+                top_done = _frames.empty();
+                break;
+            }
+            }
+        }
+    }
+};
+
+}  // namespace
+
+schema::node_index schema::_compile(const data& dat) {
+    if (dat.is_boolean()) {
+        if (dat.as_boolean()) {
+            return accept_any;
+        }
+        node n;
+        n.reject_all = true;
+        _nodes.push_back(std::move(n));
+        return static_cast<node_index>(_nodes.size() - 1);
+    }
+    if (!dat.is_object()) {
+        throw std::invalid_argument("A JSON Schema must be an object or a boolean");
+    }
+    node n;
+    bool integer = false;
+    for (const auto& [key, value] : dat.as_object()) {
+        if (key == "type") {
+            n.types = 0;
+            if (value.is_array()) {
+                for (const auto& name : value.as_array()) {
+                    n.types |= parse_type_name(name, integer);
+                }
+            } else {
+                n.types = parse_type_name(value, integer);
+            }
+        } else if (key == "properties") {
+            if (!value.is_object()) {
+                throw std::invalid_argument("JSON Schema `properties` must be an object");
+            }
+            for (const auto& [prop, prop_schema] : value.as_object()) {
+                n.properties.emplace(prop, _compile(prop_schema));
+            }
+        } else if (key == "required") {
+            if (!value.is_array()) {
+                throw std::invalid_argument("JSON Schema `required` must be an array");
+            }
+            for (const auto& name : value.as_array()) {
+                if (!name.is_string()) {
+                    throw std::invalid_argument("JSON Schema `required` names must be strings");
+                }
+                n.required.push_back(name.as_string());
+            }
+            std::sort(n.required.begin(), n.required.end());
+            n.required.erase(std::unique(n.required.begin(), n.required.end()),
+                             n.required.end());
+        } else if (key == "additionalProperties") {
+            n.additional = _compile(value);
+        } else if (key == "items") {
+            if (value.is_array()) {
+                throw std::invalid_argument("Tuple-form JSON Schema `items` is not supported");
+            }
+            n.items = _compile(value);
+        } else if (key == "enum") {
+            if (!value.is_array()) {
+                throw std::invalid_argument("JSON Schema `enum` must be an array");
+            }
+            for (const auto& elem : value.as_array()) {
+                if (elem.is_array() || elem.is_object()) {
+                    throw std::invalid_argument(
+                        "Only scalar values are supported in JSON Schema `enum`");
+                }
+            }
+            n.enum_values = value.as_array();
+        } else if (key == "minimum" || key == "maximum") {
+            if (!value.is_number()) {
+                throw std::invalid_argument("JSON Schema `" + key + "` must be a number");
+            }
+            (key == "minimum" ? n.minimum : n.maximum) = value.as_number();
+        } else if (key == "maxLength") {
+            if (!value.is_number() || value.as_number() < 0
+                || std::trunc(value.as_number()) != value.as_number()) {
+                throw std::invalid_argument(
+                    "JSON Schema `maxLength` must be a non-negative integer");
+            }
+            n.max_length = static_cast<std::size_t>(value.as_number());
+        } else if (key == "$schema" || key == "$id" || key == "title" || key == "description"
+                   || key == "default" || key == "examples") {
+            // Annotations have no effect on validation
+        } else {
+            throw std::invalid_argument("Unsupported JSON Schema keyword '" + key + "'");
+        }
+    }
+    if (integer) {
+        if (n.types & type_number) {
+            // `number` already admits every integer
+        } else {
+            n.types |= type_number;
+            n.integer_only = true;
+        }
+    }
+    _nodes.push_back(std::move(n));
+    return static_cast<node_index>(_nodes.size() - 1);
+}
+
+schema schema::compile(const data& schema_doc) {
+    schema ret;
+    ret._nodes.emplace_back();
+    ret._root = ret._compile(schema_doc);
+    return ret;
+}
+
+schema_result schema::validate(std::string_view str, parse_options opts) const {
+    return schema_walker{*this, str, opts}.run();
+}
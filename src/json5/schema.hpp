@@ -0,0 +1,96 @@
+#pragma once
+
+#include <json5/data.hpp>
+#include <json5/parse.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json5 {
+
+/**
+ * The result of validating a document against a schema. On failure, `offset` is the byte
+ * offset of the token at which the document was rejected.
+ */
+struct schema_result {
+    bool        ok     = true;
+    std::size_t offset = 0;
+    std::string reason;
+
+    explicit operator bool() const noexcept { return ok; }
+};
+
+/**
+ * A compiled subset of JSON Schema, which validates documents in a single pass over the
+ * parser's events without building any data.
+ *
+ * The supported keywords are `type` (including `integer`), `properties`, `required`,
+ * `additionalProperties`, `items` (a single schema for all elements), `enum` (of scalar
+ * values only), `minimum`, `maximum`, and `maxLength`. Schemas may also be `true` or
+ * `false`. The annotations `$schema`, `$id`, `title`, `description`, `default`, and
+ * `examples` are ignored. Any other keyword is rejected when compiling, rather than being
+ * silently ignored.
+ *
+ * A document is rejected at the first event that violates the schema, so the remainder of
+ * an invalid document is never read.
+ */
+class schema {
+public:
+    using node_index = std::uint32_t;
+
+    enum type_bits : unsigned {
+        type_null    = 1 << 0,
+        type_boolean = 1 << 1,
+        type_number  = 1 << 2,
+        type_string  = 1 << 3,
+        type_array   = 1 << 4,
+        type_object  = 1 << 5,
+        type_any     = 0x3f,
+    };
+
+    /// The index of the schema that accepts anything
+    constexpr static node_index accept_any = 0;
+
+    /// A compiled schema node. Child schemas refer to other nodes by index.
+    struct node {
+        bool                                            reject_all   = false;
+        unsigned                                        types        = type_any;
+        bool                                            integer_only = false;
+        std::optional<double>                           minimum;
+        std::optional<double>                           maximum;
+        std::optional<std::size_t>                      max_length;
+        std::optional<std::vector<data>>                enum_values;
+        std::map<std::string, node_index, std::less<>> properties;
+        /// Sorted, for lookup when a key is seen
+        std::vector<std::string> required;
+        node_index               additional = accept_any;
+        node_index               items      = accept_any;
+    };
+
+private:
+    std::vector<node> _nodes;
+    node_index        _root = accept_any;
+
+    node_index _compile(const data& dat);
+
+public:
+    /// Compile a schema document. Throws `std::invalid_argument` if it is not supported.
+    static schema compile(const data& schema_doc);
+
+    /// Validate a document against this schema
+    schema_result validate(std::string_view str, parse_options opts) const;
+    schema_result validate(std::string_view str) const {
+        return validate(str, parse_options{});
+    }
+
+    const node& node_at(node_index idx) const noexcept { return _nodes[idx]; }
+    node_index  root() const noexcept { return _root; }
+};
+
+}  // namespace json5
@@ -0,0 +1,85 @@
+#include <json5/schema.hpp>
+
+#include <json5/parse_data.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+json5::schema compile(std::string_view str) {
+    return json5::schema::compile(json5::parse_data(str));
+}
+
+const auto server_schema = compile(R"({
+    type: 'object',
+    required: ['host', 'port'],
+    properties: {
+        host: {type: 'string', maxLength: 16},
+        port: {type: 'integer', minimum: 1, maximum: 65535},
+        mode: {enum: ['fast', 'safe', null]},
+        tags: {type: 'array', items: {type: 'string'}},
+        extra: true,
+    },
+    additionalProperties: false,
+})");
+
+}  // namespace
+
+TEST_CASE("Accept documents that match a schema") {
+    CHECK(server_schema.validate("{host: 'example.com', port: 80}"));
+    CHECK(server_schema.validate("{host: 'h', port: 1, mode: null, tags: ['a', 'b']}"));
+    CHECK(server_schema.validate("{host: 'h', port: 2, extra: {anything: [1, {}]}}"));
+    CHECK(server_schema.validate("{port: 65535, host: 'ünïcödé-ünïcödé'}"));
+    CHECK(compile("true").validate("[1, 'two', {three: 3}]"));
+    CHECK(compile("{type: ['number', 'null']}").validate("null"));
+}
+
+TEST_CASE("Reject documents that do not match a schema") {
+    auto check = [](std::string_view doc, std::size_t offset, std::string_view reason) {
+        auto res = server_schema.validate(doc);
+        INFO("Document: " << doc);
+        CHECK_FALSE(res);
+        CHECK(res.offset == offset);
+        CHECK(res.reason == reason);
+    };
+    check("[]", 0, "Expected object, got array");
+    check("{host: 'h'}", 10, "Missing required property 'port'");
+    check("{host: 'h', port: 0}", 18, "Value is less than the minimum of 1");
+    check("{host: 'h', port: 70000}", 18, "Value is greater than the maximum of 65535");
+    check("{host: 'h', port: 1.5}", 18, "Expected an integer");
+    check("{host: 'h', port: '80'}", 18, "Expected number, got string");
+    check("{host: '12345678901234567', port: 1}", 7,
+          "String is longer than the maximum length of 16");
+    check("{host: 'h', port: 1, mode: 'slow'}", 27, "Value is not one of the allowed values");
+    check("{host: 'h', port: 1, tags: ['a', 2]}", 33, "Expected string, got number");
+    check("{host: 'h', port: 1, color: 'red'}", 21, "Property 'color' is not allowed");
+    check("{host: 'h', port: 1", 19, "Unterminated object literal");
+    check("{host: 'h', port: 1} 2", 21, "Trailing characters in JSON data");
+    check("", 0, "Unexpected end-of-input");
+    check("{host: 'h', port: 1" + std::string(400, '0') + "}", 18, "Number is out of range");
+}
+
+TEST_CASE("Report resource limits while checking values") {
+    json5::parse_options opts       = json5::json5_options;
+    opts.limits.max_allocated_bytes = 8;
+    auto res = server_schema.validate("{host: 'example.com', port: 80}", opts);
+    CHECK_FALSE(res);
+    CHECK(res.offset == 7);
+    CHECK_THAT(res.reason, Catch::Contains("Document exceeds the allocation limit"));
+}
+
+TEST_CASE("Reject at the first violating event") {
+    // The syntax error after the violation is never reached
+    auto res = server_schema.validate("{host: 5, port: @@@");
+    CHECK(res.reason == "Expected string, got number");
+    CHECK(compile("false").validate("1").reason == "Value is not allowed by the schema");
+}
+
+TEST_CASE("Compile errors for unsupported schemas") {
+    CHECK_THROWS_AS(compile("{pattern: '^a'}"), std::invalid_argument);
+    CHECK_THROWS_AS(compile("{type: 'thing'}"), std::invalid_argument);
+    CHECK_THROWS_AS(compile("{items: [{}, {}]}"), std::invalid_argument);
+    CHECK_THROWS_AS(compile("{enum: [[1]]}"), std::invalid_argument);
+    CHECK_THROWS_AS(compile("42"), std::invalid_argument);
+    CHECK_NOTHROW(compile("{title: 'x', description: 'y', $schema: 'z'}"));
+}
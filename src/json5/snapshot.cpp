@@ -0,0 +1,194 @@
+#include "./snapshot.hpp"
+
+#include <fstream>
+#include <sstream>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JSON5_SNAPSHOT_HAVE_MMAP 1
+#else
+#define JSON5_SNAPSHOT_HAVE_MMAP 0
+#endif
+
+using namespace json5;
+using namespace json5::detail;
+
+namespace {
+
+constexpr char snapshot_magic[4] = {'J', '5', 'S', 'N'};
+
+void put_word(std::string& out, std::uint32_t w) {
+    char bytes[4];
+    std::memcpy(bytes, &w, sizeof bytes);
+    out.append(bytes, sizeof bytes);
+}
+
+std::uint32_t get_word(std::string_view image, std::size_t n) {
+    std::uint32_t ret;
+    std::memcpy(&ret, image.data() + n * 4, sizeof ret);
+    return ret;
+}
+
+}  // namespace
+
+void json5::detail::throw_snapshot_error(std::string_view message) {
+    throw parse_error("Invalid JSON5 snapshot: " + std::string(message));
+}
+
+std::uint32_t snapshot_writer::put_node(const std::uint32_t* words, std::size_t n_words) {
+    const auto offset = snapshot_head_size + _nodes.size();
+    if (offset > UINT32_MAX) {
+        throw_snapshot_error("Snapshot image would exceed 4GiB");
+    }
+    for (auto it = words; it != words + n_words; ++it) {
+        put_word(_nodes, *it);
+    }
+    return static_cast<std::uint32_t>(offset);
+}
+
+std::uint32_t snapshot_writer::put_number(double d) {
+    // Keep the double 8-byte aligned within the image (the header is a multiple of 8)
+    if (_nodes.size() % 8 != 0) {
+        put_word(_nodes, 0);
+    }
+    std::uint32_t words[4] = {std::uint32_t(snapshot_kind::number), 0, 0, 0};
+    std::memcpy(words + 2, &d, sizeof d);
+    return put_node(words, 4);
+}
+
+std::uint32_t snapshot_writer::put_string(std::string_view str) {
+    auto [it, did_insert] = _pool_index.try_emplace(std::string(str),
+                                                    static_cast<std::uint32_t>(_pool.size()));
+    if (did_insert) {
+        _pool.append(str);
+    }
+    return it->second;
+}
+
+std::string snapshot_writer::finish(std::uint32_t root) {
+    const auto pool_offset = snapshot_head_size + _nodes.size();
+    if (pool_offset + _pool.size() > UINT32_MAX) {
+        throw_snapshot_error("Snapshot image would exceed 4GiB");
+    }
+    std::string ret;
+    ret.reserve(pool_offset + _pool.size());
+    ret.append(snapshot_magic, sizeof snapshot_magic);
+    put_word(ret, snapshot_version);
+    put_word(ret, snapshot_bom);
+    put_word(ret, root);
+    put_word(ret, static_cast<std::uint32_t>(pool_offset));
+    put_word(ret, static_cast<std::uint32_t>(_pool.size()));
+    ret.append(_nodes);
+    ret.append(_pool);
+    return ret;
+}
+
+std::string_view snapshot_node::_pool_string(std::uint32_t len, std::uint32_t pool_offset) const {
+    const auto pool_begin = std::size_t(get_word(_image, 4));
+    const auto pool_size  = std::size_t(get_word(_image, 5));
+    if (std::size_t(pool_offset) + len > pool_size) {
+        throw_snapshot_error("Snapshot string is out of bounds");
+    }
+    return _image.substr(pool_begin + pool_offset, len);
+}
+
+double snapshot_node::as_number() const {
+    _require(snapshot_kind::number);
+    // Check the bounds of the second half of the double
+    _word(3);
+    double ret;
+    std::memcpy(&ret, _image.data() + _offset + 8, sizeof ret);
+    return ret;
+}
+
+std::optional<snapshot_node> snapshot_node::find(std::string_view key) const {
+    std::size_t low  = 0;
+    std::size_t high = size();
+    while (low < high) {
+        const auto mid     = low + (high - low) / 2;
+        const auto mid_key = key_at(mid);
+        if (mid_key < key) {
+            low = mid + 1;
+        } else if (key < mid_key) {
+            high = mid;
+        } else {
+            return value_at(mid);
+        }
+    }
+    return std::nullopt;
+}
+
+snapshot_view::snapshot_view(std::string_view image)
+    : _image(image) {
+    if (image.size() < snapshot_head_size
+        || std::memcmp(image.data(), snapshot_magic, sizeof snapshot_magic) != 0) {
+        throw_snapshot_error("Missing snapshot header");
+    }
+    if (get_word(image, 1) != snapshot_version) {
+        throw_snapshot_error("Unsupported snapshot version");
+    }
+    if (get_word(image, 2) != snapshot_bom) {
+        throw_snapshot_error("Snapshot was compiled with a different byte order");
+    }
+    const auto pool_offset = std::size_t(get_word(image, 4));
+    const auto pool_size   = std::size_t(get_word(image, 5));
+    if (pool_offset + pool_size > image.size()) {
+        throw_snapshot_error("Snapshot image is truncated");
+    }
+    _root = get_word(image, 3);
+    // The root node lies between the header and the string pool
+    if (_root < snapshot_head_size || std::size_t(_root) + 4 > pool_offset) {
+        throw_snapshot_error("Snapshot root node is out of bounds");
+    }
+}
+
+snapshot_file::snapshot_file(const std::filesystem::path& filepath) {
+#if JSON5_SNAPSHOT_HAVE_MMAP
+    const int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::filesystem::filesystem_error("Failed to open snapshot file",
+                                                filepath,
+                                                std::error_code(errno, std::system_category()));
+    }
+    struct ::stat st;
+    if (::fstat(fd, &st) != 0) {
+        auto ec = std::error_code(errno, std::system_category());
+        ::close(fd);
+        throw std::filesystem::filesystem_error("Failed to stat snapshot file", filepath, ec);
+    }
+    const auto size = static_cast<std::size_t>(st.st_size);
+    if (size != 0) {
+        void* addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {
+            auto ec = std::error_code(errno, std::system_category());
+            ::close(fd);
+            throw std::filesystem::filesystem_error("Failed to map snapshot file", filepath, ec);
+        }
+        _mapping = addr;
+        _image   = std::string_view(static_cast<const char*>(addr), size);
+    }
+    ::close(fd);
+#else
+    std::ifstream infile{filepath, std::ios::binary};
+    if (!infile) {
+        throw std::filesystem::filesystem_error("Failed to open snapshot file",
+                                                filepath,
+                                                std::make_error_code(std::errc::io_error));
+    }
+    std::stringstream strm;
+    strm << infile.rdbuf();
+    _buffer = std::move(strm).str();
+    _image  = _buffer;
+#endif
+}
+
+snapshot_file::~snapshot_file() {
+#if JSON5_SNAPSHOT_HAVE_MMAP
+    if (_mapping) {
+        ::munmap(_mapping, _image.size());
+    }
+#endif
+}
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <json5/data.hpp>
+#include <json5/parse_data.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace json5 {
+
+/**
+ * Snapshots: A pointer-free binary image of a JSON5 document
+ * ==========================================================
+ *
+ * A snapshot is compiled once from a `basic_data` and can then be queried in place by a
+ * `snapshot_view` without any deserialization. A snapshot image contains no pointers, so
+ * it may be written to a file and memory-mapped by any number of processes.
+ *
+ * Image layout
+ * ------------
+ *
+ * All integers are 32-bit and in the byte order of the machine that compiled the
+ * snapshot (the header records this, and a mismatched image is rejected).
+ *
+ *  - Header: magic `J5SN`, version, byte-order mark, root node offset, string pool
+ *    offset, and string pool size.
+ *  - Nodes: Each node begins with its kind. Offsets to nodes are from the start of the
+ *    image. Children are written before their parents.
+ *      - null: `[kind]`
+ *      - boolean: `[kind][value]`
+ *      - number: `[kind][padding][64-bit double]`
+ *      - string: `[kind][length][pool offset]`
+ *      - array: `[kind][count][element node offset...]`
+ *      - object: `[kind][count]([key length][key pool offset][value node offset]...)`,
+ *        with members sorted by key so that lookups can use a binary search.
+ *  - String pool: The bytes of all strings and keys. Identical strings are stored once.
+ *
+ * Because offsets are 32-bit, a snapshot image is limited to 4GiB.
+ */
+
+namespace detail {
+
+enum class snapshot_kind : std::uint32_t {
+    null    = 1,
+    boolean = 2,
+    number  = 3,
+    string  = 4,
+    array   = 5,
+    object  = 6,
+};
+
+constexpr inline std::uint32_t snapshot_version   = 1;
+constexpr inline std::uint32_t snapshot_bom       = 0x01020304;
+constexpr inline std::size_t   snapshot_head_size = 24;
+
+[[noreturn]] void throw_snapshot_error(std::string_view message);
+
+/**
+ * Accumulates the nodes and string pool of a snapshot image.
+ */
+class snapshot_writer {
+    std::string                                    _nodes;
+    std::string                                    _pool;
+    std::unordered_map<std::string, std::uint32_t> _pool_index;
+
+public:
+    /// Append the given words as a new node, and return the offset of that node
+    std::uint32_t put_node(const std::uint32_t* words, std::size_t n_words);
+    std::uint32_t put_number(double d);
+    /// Intern a string into the pool, and return its offset within the pool
+    std::uint32_t put_string(std::string_view str);
+
+    /// Generate the final image, with the node at the given offset as the root
+    std::string finish(std::uint32_t root);
+};
+
+template <typename Data>
+std::uint32_t compile_snapshot_inner(snapshot_writer& out, const Data& dat) {
+    using k = snapshot_kind;
+    if (dat.is_null()) {
+        const std::uint32_t words[] = {std::uint32_t(k::null)};
+        return out.put_node(words, 1);
+    } else if (dat.is_boolean()) {
+        const std::uint32_t words[] = {std::uint32_t(k::boolean), dat.as_boolean() ? 1u : 0u};
+        return out.put_node(words, 2);
+    } else if (dat.is_number()) {
+        return out.put_number(static_cast<double>(dat.as_number()));
+    } else if (dat.is_string()) {
+        const auto&         str     = dat.as_string();
+        const std::uint32_t words[] = {std::uint32_t(k::string),
+                                       static_cast<std::uint32_t>(str.size()),
+                                       out.put_string({str.data(), str.size()})};
+        return out.put_node(words, 3);
+    } else if (dat.is_array()) {
+        std::vector<std::uint32_t> words = {std::uint32_t(k::array),
+                                            static_cast<std::uint32_t>(dat.as_array().size())};
+        for (const auto& elem : dat.as_array()) {
+            words.push_back(compile_snapshot_inner(out, elem));
+        }
+        return out.put_node(words.data(), words.size());
+    } else {
+        struct member {
+            std::string_view key;
+            std::uint32_t    value;
+        };
+        std::vector<member> members;
+        for (const auto& [key, value] : dat.as_object()) {
+            members.push_back({{key.data(), key.size()}, compile_snapshot_inner(out, value)});
+        }
+        std::sort(members.begin(), members.end(), [](const member& l, const member& r) {
+            return l.key < r.key;
+        });
+        std::vector<std::uint32_t> words = {std::uint32_t(k::object),
+                                            static_cast<std::uint32_t>(members.size())};
+        for (const auto& m : members) {
+            words.push_back(static_cast<std::uint32_t>(m.key.size()));
+            words.push_back(out.put_string(m.key));
+            words.push_back(m.value);
+        }
+        return out.put_node(words.data(), words.size());
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Compile the given data into a snapshot image.
+ */
+template <typename Data>
+std::string compile_snapshot(const Data& dat) {
+    detail::snapshot_writer out;
+    auto                    root = detail::compile_snapshot_inner(out, dat);
+    return out.finish(root);
+}
+
+/**
+ * A reference to a single value within a snapshot image. This is a lightweight handle
+ * that should be passed by value. Accessing a value as the wrong kind, or an offset that
+ * is outside of the image, will throw a `parse_error`.
+ *
+ * Nodes are only obtained from a `snapshot_view`, or from other nodes, so that the header
+ * of the image has always been validated.
+ */
+class snapshot_node {
+    std::string_view _image;
+    std::uint32_t    _offset = 0;
+
+    friend class snapshot_view;
+
+    snapshot_node(std::string_view image, std::uint32_t offset)
+        : _image(image)
+        , _offset(offset) {}
+
+    std::uint32_t _word(std::size_t n) const {
+        const auto pos = std::size_t(_offset) + n * 4;
+        if (pos + 4 > _image.size()) {
+            detail::throw_snapshot_error("Snapshot node is out of bounds");
+        }
+        std::uint32_t ret;
+        std::memcpy(&ret, _image.data() + pos, sizeof ret);
+        return ret;
+    }
+
+    detail::snapshot_kind _kind() const { return detail::snapshot_kind(_word(0)); }
+
+    void _require(detail::snapshot_kind k) const {
+        if (_kind() != k) {
+            detail::throw_snapshot_error("Snapshot node accessed as the wrong kind");
+        }
+    }
+
+    std::string_view _pool_string(std::uint32_t len, std::uint32_t pool_offset) const;
+
+    /// Obtain word `n` of the object member at `idx`
+    std::uint32_t _member_word(std::size_t idx, std::size_t n) const {
+        if (idx >= size()) {
+            detail::throw_snapshot_error("Snapshot object member index is out of range");
+        }
+        return _word(2 + idx * 3 + n);
+    }
+
+public:
+    bool is_null() const { return _kind() == detail::snapshot_kind::null; }
+    bool is_boolean() const { return _kind() == detail::snapshot_kind::boolean; }
+    bool is_number() const { return _kind() == detail::snapshot_kind::number; }
+    bool is_string() const { return _kind() == detail::snapshot_kind::string; }
+    bool is_array() const { return _kind() == detail::snapshot_kind::array; }
+    bool is_object() const { return _kind() == detail::snapshot_kind::object; }
+
+    bool as_boolean() const {
+        _require(detail::snapshot_kind::boolean);
+        return _word(1) != 0;
+    }
+
+    double as_number() const;
+
+    std::string_view as_string() const {
+        _require(detail::snapshot_kind::string);
+        return _pool_string(_word(1), _word(2));
+    }
+
+    /// The number of elements of an array, or the number of members of an object
+    std::size_t size() const {
+        if (!is_array()) {
+            _require(detail::snapshot_kind::object);
+        }
+        return _word(1);
+    }
+
+    /// Obtain the element of an array at the given index
+    snapshot_node operator[](std::size_t idx) const {
+        _require(detail::snapshot_kind::array);
+        if (idx >= size()) {
+            detail::throw_snapshot_error("Snapshot array index is out of range");
+        }
+        return snapshot_node(_image, _word(2 + idx));
+    }
+
+    /// Obtain the key of the Nth member of an object. Members are sorted by key.
+    std::string_view key_at(std::size_t idx) const {
+        _require(detail::snapshot_kind::object);
+        return _pool_string(_member_word(idx, 0), _member_word(idx, 1));
+    }
+
+    /// Obtain the value of the Nth member of an object. Members are sorted by key.
+    snapshot_node value_at(std::size_t idx) const {
+        _require(detail::snapshot_kind::object);
+        return snapshot_node(_image, _member_word(idx, 2));
+    }
+
+    /// Find the value of the object member with the given key
+    std::optional<snapshot_node> find(std::string_view key) const;
+};
+
+/**
+ * A view of a snapshot image that resides in memory. The view does not own the image.
+ */
+class snapshot_view {
+    std::string_view _image;
+    std::uint32_t    _root = 0;
+
+public:
+    /// Create a view of the given image. Throws `parse_error` if the header is invalid.
+    explicit snapshot_view(std::string_view image);
+
+    snapshot_node root() const noexcept { return snapshot_node(_image, _root); }
+
+    std::string_view image() const noexcept { return _image; }
+};
+
+/**
+ * A snapshot image file mapped into memory. Where memory mapping is not available, the
+ * file is read into memory instead.
+ */
+class snapshot_file {
+    std::string_view _image;
+    std::string      _buffer;
+    void*            _mapping = nullptr;
+
+public:
+    explicit snapshot_file(const std::filesystem::path& filepath);
+    ~snapshot_file();
+
+    snapshot_file(const snapshot_file&) = delete;
+    snapshot_file& operator=(const snapshot_file&) = delete;
+
+    snapshot_view view() const { return snapshot_view(_image); }
+};
+
+}  // namespace json5
@@ -0,0 +1,78 @@
+#include <json5/snapshot.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <fstream>
+#include <string>
+
+#if defined(_WIN32)
+#include <process.h>
+#define JSON5_TEST_GETPID _getpid
+#else
+#include <unistd.h>
+#define JSON5_TEST_GETPID getpid
+#endif
+
+TEST_CASE("Compile and query a snapshot") {
+    auto doc = json5::parse_data(R"({
+        name: 'vob-json5',
+        version: [0, 1, 6],
+        ratio: -2.25,
+        flags: {debug: true, extra: null},
+        alias: 'vob-json5',
+    })");
+
+    auto image = json5::compile_snapshot(doc);
+    auto view  = json5::snapshot_view(image);
+    auto root  = view.root();
+
+    REQUIRE(root.is_object());
+    CHECK(root.size() == 5);
+    CHECK(root.key_at(0) == "alias");
+    CHECK(root.find("name")->as_string() == "vob-json5");
+    CHECK(root.find("ratio")->as_number() == -2.25);
+    CHECK_FALSE(root.find("missing"));
+
+    auto version = root.find("version");
+    REQUIRE(version);
+    REQUIRE(version->is_array());
+    CHECK(version->size() == 3);
+    CHECK((*version)[2].as_number() == 6);
+    CHECK_THROWS_AS((*version)[3], json5::parse_error);
+
+    auto flags = root.find("flags");
+    CHECK(flags->find("debug")->as_boolean());
+    CHECK(flags->find("extra")->is_null());
+    CHECK_THROWS_AS(flags->find("debug")->as_string(), json5::parse_error);
+}
+
+TEST_CASE("Reject invalid snapshots") {
+    CHECK_THROWS_AS(json5::snapshot_view(""), json5::parse_error);
+    CHECK_THROWS_AS(json5::snapshot_view("J5SN but not really a snapshot"), json5::parse_error);
+
+    auto image = json5::compile_snapshot(json5::data("string"));
+    image.resize(image.size() - 1);
+    CHECK_THROWS_AS(json5::snapshot_view(image), json5::parse_error);
+
+    // A root offset that points into the header
+    image = json5::compile_snapshot(json5::data("string"));
+    image[12] = image[13] = image[14] = image[15] = '\0';
+    CHECK_THROWS_AS(json5::snapshot_view(image), json5::parse_error);
+}
+
+TEST_CASE("Map a snapshot file") {
+    // Unique to this process, so that concurrent test runs do not collide
+    auto filepath = std::filesystem::temp_directory_path()
+        / ("json5-snapshot-test-" + std::to_string(JSON5_TEST_GETPID()) + ".j5sn");
+    {
+        std::ofstream out{filepath, std::ios::binary};
+        out << json5::compile_snapshot(json5::parse_data("[1, 'two', {three: 3}]"));
+    }
+    {
+        json5::snapshot_file file{filepath};
+        auto                 root = file.view().root();
+        CHECK(root[1].as_string() == "two");
+        CHECK(root[2].find("three")->as_number() == 3);
+    }
+    std::filesystem::remove(filepath);
+}
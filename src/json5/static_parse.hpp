@@ -0,0 +1,679 @@
+#pragma once
+
+#include <json5/parse.hpp>
+#include <json5/parse_data.hpp>
+#include <json5/unicode.hpp>
+
+/**
+ * Compile-time parsing requires compiler support for `consteval`. Without it, this header
+ * provides nothing.
+ */
+#if defined(__cpp_consteval)
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+
+namespace json5 {
+
+/**
+ * Compile-time parsing
+ * ====================
+ *
+ * `static_parse<"...">()` parses a JSON5 string literal during compilation, and produces a
+ * read-only `static_document` that can be queried in constant expressions or at runtime.
+ * Invalid input is a compile error.
+ *
+ * The runtime tokenizer and parser are not usable in constant expressions, so this is a
+ * separate recursive-descent implementation of the same grammar. It follows the behavior
+ * of `parse_data()`, including the handling of `parse_options` and of string escapes.
+ * Every `parse_limits` is applied except `max_allocated_bytes`, since a static document
+ * allocates nothing.
+ *
+ * Number values are computed at compile time. They are exact for integers up to 2^53, and
+ * correctly rounded for decimals with up to 15 significant digits and 22 decimal places.
+ *
+ * Note that compilers limit the depth of recursion in constant evaluation, which may be
+ * lower than the nesting limit of 1024 that is allowed by the runtime parser.
+ */
+
+template <std::size_t N>
+struct fixed_string {
+    char chars[N] = {};
+
+    constexpr fixed_string(const char (&str)[N]) noexcept {
+        for (std::size_t i = 0; i != N; ++i) {
+            chars[i] = str[i];
+        }
+    }
+
+    constexpr std::string_view view() const noexcept { return std::string_view(chars, N - 1); }
+};
+
+enum class static_kind : unsigned char {
+    null,
+    boolean,
+    number,
+    string,
+    array,
+    object,
+};
+
+/**
+ * A node in a static document. Nodes are stored in pre-order: The children of an array or
+ * object immediately follow it, and `extent` gives the number of nodes in each subtree.
+ */
+struct static_node {
+    static_kind kind       = static_kind::null;
+    bool        boolean    = false;
+    double      number     = 0;
+    std::size_t str_offset = 0;
+    std::size_t str_size   = 0;
+    /// The key of this node, if it is the value of an object member
+    std::size_t key_offset = 0;
+    std::size_t key_size   = 0;
+    /// The number of children of an array or object
+    std::size_t size = 0;
+    /// The number of nodes in this subtree, including this node
+    std::size_t extent = 1;
+};
+
+namespace detail {
+
+/// Reaching a call to this in constant evaluation fails the compilation with this message.
+[[noreturn]] inline void static_data_error(const char* message) { throw parse_error(message); }
+
+constexpr bool static_is_space(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+constexpr bool static_is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+constexpr bool static_is_ident_first(char c) noexcept {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$';
+}
+constexpr bool static_is_ident_char(char c) noexcept {
+    return static_is_ident_first(c) || static_is_digit(c);
+}
+constexpr bool static_is_ascii(char c) noexcept { return static_cast<unsigned char>(c) < 0x80; }
+
+/**
+ * Parses a JSON5 document in a constant expression. If `nodes` and `pool` are null, then
+ * nothing is written and only the required sizes are computed.
+ */
+struct static_parser {
+    std::string_view str;
+    parse_options    opts;
+
+    static_node* nodes = nullptr;
+    char*        pool  = nullptr;
+
+    std::size_t pos     = 0;
+    std::size_t n_nodes = 0;
+    std::size_t n_pool  = 0;
+    std::size_t depth   = 0;
+    /// The number of values parsed, including those of duplicate keys that are dropped
+    std::size_t n_values = 0;
+
+    constexpr char peek(std::size_t n = 0) const noexcept {
+        return pos + n < str.size() ? str[pos + n] : '\0';
+    }
+    constexpr bool at_end() const noexcept { return pos >= str.size(); }
+
+    /// The length of the valid UTF-8 sequence at the current position
+    constexpr std::size_t utf8_len() const {
+        char32_t   cp  = 0;
+        const auto len = utf8_decode(str.data() + pos, str.data() + str.size(), cp);
+        if (len == 0) {
+            static_data_error("Invalid UTF-8 in input");
+        }
+        return static_cast<std::size_t>(len);
+    }
+
+    /// The length of the identifier character at the current position, or zero if none
+    constexpr std::size_t ident_char_len(bool first) const noexcept {
+        if (at_end()) {
+            return 0;
+        }
+        if (static_is_ascii(peek())) {
+            return (first ? static_is_ident_first(peek()) : static_is_ident_char(peek())) ? 1 : 0;
+        }
+        char32_t   cp  = 0;
+        const auto len = utf8_decode(str.data() + pos, str.data() + str.size(), cp);
+        const bool ok  = first ? is_unicode_id_start(cp) : is_unicode_id_continue(cp);
+        return len != 0 && ok ? static_cast<std::size_t>(len) : 0;
+    }
+
+    constexpr void skip_trivia() {
+        while (!at_end()) {
+            if (static_is_space(peek())) {
+                ++pos;
+            } else if (peek() == '/' && (peek(1) == '/' || peek(1) == '*')) {
+                if (opts.c_comments == toggle::off) {
+                    static_data_error("Comments are not allowed.");
+                }
+                if (peek(1) == '/') {
+                    while (!at_end() && peek() != '\n' && peek() != '\r') {
+                        pos += static_is_ascii(peek()) ? 1 : utf8_len();
+                    }
+                } else {
+                    // As in the tokenizer, the `*` that opens a block comment may also close it
+                    pos += 1;
+                    while (!(peek() == '*' && peek(1) == '/')) {
+                        if (at_end()) {
+                            static_data_error("Unterminated block comment");
+                        }
+                        pos += static_is_ascii(peek()) ? 1 : utf8_len();
+                    }
+                    pos += 2;
+                }
+            } else {
+                break;
+            }
+        }
+    }
+
+    constexpr void put_char(char c) {
+        if (pool) {
+            pool[n_pool] = c;
+        }
+        ++n_pool;
+    }
+
+    /// Parse a string literal into the pool. Escapes are handled as by `realize_string()`.
+    constexpr void parse_string(std::size_t& offset, std::size_t& size) {
+        const char quote = peek();
+        if (quote == '\'' && opts.single_quote_strings == toggle::off) {
+            static_data_error("Single-quote strings are not allowed.");
+        }
+        const auto start = ++pos;
+        offset = n_pool;
+        while (true) {
+            if (at_end() || peek() == '\n' || peek() == '\r') {
+                static_data_error("Unterminated string");
+            }
+            if (!static_is_ascii(peek())) {
+                for (auto len = utf8_len(); len != 0; --len) {
+                    put_char(str[pos++]);
+                }
+                continue;
+            }
+            const char c = str[pos++];
+            if (c == quote) {
+                break;
+            }
+            if (c != '\\') {
+                put_char(c);
+                continue;
+            }
+            if (at_end()) {
+                static_data_error("Unterminated string");
+            }
+            if (!static_is_ascii(peek())) {
+                // Like `realize_string()`, only the first byte of the escaped character is
+                // dropped.
+                auto len = utf8_len();
+                for (++pos; len != 1; --len) {
+                    put_char(str[pos++]);
+                }
+                continue;
+            }
+            const char esc = str[pos++];
+            switch (esc) {
+            case '"':
+            case '\'':
+            case '\\':
+                put_char(esc);
+                break;
+            case 'n':
+                put_char('\n');
+                break;
+            case 'r':
+                put_char('\r');
+                break;
+            case '\r':
+                if (!at_end() && peek() == '\n') {
+                    ++pos;
+                } else {
+                    break;
+                }
+                [[fallthrough]];
+            case '\n':
+                if (opts.escape_newline_strings == toggle::off) {
+                    static_data_error("Escaped newlines in strings are not allowed.");
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        if (pos - start - 1 > opts.limits.max_string_length) {
+            static_data_error("String exceeds the length limit");
+        }
+        size = n_pool - offset;
+    }
+
+    constexpr std::string_view parse_ident() {
+        const auto start = pos;
+        pos += ident_char_len(true);
+        for (auto len = ident_char_len(false); len != 0; len = ident_char_len(false)) {
+            pos += len;
+        }
+        return str.substr(start, pos - start);
+    }
+
+    constexpr double parse_number() {
+        bool negative = false;
+        if (peek() == '+' || peek() == '-') {
+            negative = peek() == '-';
+            ++pos;
+        }
+        if (peek() == '.' && !static_is_digit(peek(1))) {
+            static_data_error("Invalid token");
+        }
+        if (!static_is_digit(peek()) && peek() != '.') {
+            static_data_error("Invalid number literal");
+        }
+        // Accumulate up to 19 significant digits into an integer mantissa
+        std::uint64_t mantissa    = 0;
+        int           n_digits    = 0;
+        int           exponent    = 0;
+        auto          take_digits = [&](bool fractional) {
+            while (static_is_digit(peek())) {
+                const auto d = static_cast<std::uint64_t>(peek() - '0');
+                if (n_digits < 19) {
+                    mantissa = mantissa * 10 + d;
+                    if (mantissa != 0) {
+                        ++n_digits;
+                    }
+                    if (fractional) {
+                        --exponent;
+                    }
+                } else if (!fractional) {
+                    ++exponent;
+                }
+                ++pos;
+            }
+        };
+        take_digits(false);
+        if (peek() == '.' && static_is_digit(peek(1))) {
+            ++pos;
+            take_digits(true);
+        }
+        double value = static_cast<double>(mantissa);
+        double scale = 1;
+        for (int e = exponent < 0 ? -exponent : exponent; e != 0; --e) {
+            scale *= 10;
+        }
+        value = exponent < 0 ? value / scale : value * scale;
+        return negative ? -value : value;
+    }
+
+    constexpr std::size_t new_node(static_kind kind) {
+        if (++n_values > opts.limits.max_nodes) {
+            static_data_error("Document exceeds the value limit");
+        }
+        const auto idx = n_nodes++;
+        if (nodes) {
+            nodes[idx]      = static_node{};
+            nodes[idx].kind = kind;
+        }
+        return idx;
+    }
+
+    /**
+     * Parse a value, which may be the value of an object member with the given key. `in`
+     * is the opening bracket of the enclosing array or object, if any.
+     */
+    constexpr void parse_value(char in, std::size_t key_offset = 0, std::size_t key_size = 0) {
+        skip_trivia();
+        if (at_end()) {
+            static_data_error("Unexpected end-of-input: Expected a value");
+        }
+        const char c     = peek();
+        std::size_t idx  = 0;
+        if (c == '[' || c == '{') {
+            if (depth == 1024 || depth >= opts.limits.max_depth) {
+                static_data_error("Array/object nesting is too deep.");
+            }
+            ++depth;
+            idx = c == '[' ? parse_array() : parse_object();
+            --depth;
+        } else if (c == '"' || c == '\'') {
+            idx = new_node(static_kind::string);
+            std::size_t offset = 0;
+            std::size_t size   = 0;
+            parse_string(offset, size);
+            if (nodes) {
+                nodes[idx].str_offset = offset;
+                nodes[idx].str_size   = size;
+            }
+        } else if (ident_char_len(true) != 0) {
+            const auto ident = parse_ident();
+            if (ident == "null") {
+                idx = new_node(static_kind::null);
+            } else if (ident == "true" || ident == "false") {
+                idx = new_node(static_kind::boolean);
+                if (nodes) {
+                    nodes[idx].boolean = ident == "true";
+                }
+            } else if (ident == "Infinity" || ident == "NaN") {
+                idx = new_node(static_kind::number);
+                if (nodes) {
+                    nodes[idx].number = ident == "NaN" ? std::numeric_limits<double>::quiet_NaN()
+                                                       : std::numeric_limits<double>::infinity();
+                }
+            } else {
+                static_data_error("An object key identifier is not a valid value.");
+            }
+        } else if (static_is_digit(c) || c == '.' || c == '+' || c == '-') {
+            idx           = new_node(static_kind::number);
+            const auto nv = parse_number();
+            if (nodes) {
+                nodes[idx].number = nv;
+            }
+        } else if (c == ',') {
+            static_data_error(in == '['   ? "Extraneous `,` in array literal."
+                              : in == '{' ? "Expected value before `,` in object literal."
+                                          : "Unexpected `,`");
+        } else if (c == ']') {
+            static_data_error("Unexpected closing `]`");
+        } else if (c == '}') {
+            static_data_error("Unexpected closing `}`");
+        } else if (c == ':') {
+            static_data_error("Unexpected `:`");
+        } else {
+            if (!static_is_ascii(c)) {
+                utf8_len();
+            }
+            static_data_error("Invalid token");
+        }
+        if (nodes) {
+            nodes[idx].key_offset = key_offset;
+            nodes[idx].key_size   = key_size;
+            nodes[idx].extent     = n_nodes - idx;
+        }
+    }
+
+    /// Parse a `,` or the closing bracket of a container. Returns `true` at the closing.
+    constexpr bool parse_tail(char close) {
+        skip_trivia();
+        if (peek() == close) {
+            ++pos;
+            return true;
+        }
+        const char* unterminated
+            = close == ']' ? "Unterminated array literal" : "Unterminated object literal";
+        if (at_end()) {
+            static_data_error(unterminated);
+        }
+        if (peek() != ',') {
+            static_data_error(close == ']' ? "Expected `,` or `]` in array"
+                                           : "Expected `,` or `}` in object");
+        }
+        ++pos;
+        skip_trivia();
+        if (at_end() && (close == '}' || opts.trailing_commas == toggle::on)) {
+            static_data_error(unterminated);
+        }
+        if (peek() == close) {
+            if (opts.trailing_commas == toggle::off) {
+                static_data_error(close == ']'
+                                      ? "Trailing commas are not allowed: Expected an array value."
+                                      : "Trailing commas are not allowed: Expected an object key.");
+            }
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    constexpr std::size_t parse_array() {
+        const auto idx = new_node(static_kind::array);
+        ++pos;
+        skip_trivia();
+        std::size_t size = 0;
+        if (at_end()) {
+            static_data_error("Unterminated array literal");
+        } else if (peek() == ']') {
+            ++pos;
+        } else {
+            do {
+                parse_value('[');
+                if (++size > opts.limits.max_elements) {
+                    static_data_error("Array/object exceeds the element limit");
+                }
+            } while (!parse_tail(']'));
+        }
+        if (nodes) {
+            nodes[idx].size = size;
+        }
+        return idx;
+    }
+
+    constexpr std::size_t parse_object() {
+        const auto idx = new_node(static_kind::object);
+        ++pos;
+        skip_trivia();
+        std::size_t size      = 0;
+        std::size_t n_members = 0;
+        if (peek() == '}') {
+            ++pos;
+        } else {
+            do {
+                skip_trivia();
+                std::size_t key_offset = n_pool;
+                std::size_t key_size   = 0;
+                const char  k          = peek();
+                const char* bad_key    = opts.bare_ident_keys == toggle::on
+                    ? "Object member keys must be strings or identifiers."
+                    : "Object member keys must be strings.";
+                if (k == '"' || k == '\'') {
+                    parse_string(key_offset, key_size);
+                } else if (ident_char_len(true) != 0) {
+                    const auto ident = parse_ident();
+                    if (ident == "null" || ident == "true" || ident == "false"
+                        || ident == "Infinity" || ident == "NaN") {
+                        static_data_error(bad_key);
+                    }
+                    if (opts.bare_ident_keys == toggle::off) {
+                        static_data_error("Bare identifier object keys are not allowed.");
+                    }
+                    if (ident.size() > opts.limits.max_string_length) {
+                        static_data_error("String exceeds the length limit");
+                    }
+                    for (char c : ident) {
+                        put_char(c);
+                    }
+                    key_size = ident.size();
+                } else if (at_end()) {
+                    static_data_error("Unterminated object literal");
+                } else if (k == ',') {
+                    static_data_error("Extraneous `,` in object literal.");
+                } else if (k == '{' || k == '[' || static_is_digit(k) || k == '.' || k == '+'
+                           || k == '-') {
+                    static_data_error(bad_key);
+                } else {
+                    static_data_error("Expected an object member or closing brace `}`");
+                }
+                skip_trivia();
+                if (peek() != ':') {
+                    static_data_error("Expected `:` following object member key");
+                }
+                ++pos;
+                const auto member = n_nodes;
+                parse_value('{', key_offset, key_size);
+                // Duplicate members count against the limit, as in the runtime parser
+                if (++n_members > opts.limits.max_elements) {
+                    static_data_error("Array/object exceeds the element limit");
+                }
+                if (nodes && has_key(idx, size, key_offset, key_size)) {
+                    // As with parse_data, the first of any duplicate keys is kept. The
+                    // space that was measured for this member is left unused.
+                    n_nodes = member;
+                    n_pool  = key_offset;
+                } else {
+                    ++size;
+                }
+            } while (!parse_tail('}'));
+        }
+        if (nodes) {
+            nodes[idx].size = size;
+        }
+        return idx;
+    }
+
+    /// Whether any of the first `size` members of the object at `idx` has the given key
+    constexpr bool has_key(std::size_t idx,
+                           std::size_t size,
+                           std::size_t key_offset,
+                           std::size_t key_size) const noexcept {
+        const auto key   = std::string_view(pool + key_offset, key_size);
+        auto       child = idx + 1;
+        for (std::size_t n = 0; n != size; ++n) {
+            const auto& node = nodes[child];
+            if (std::string_view(pool + node.key_offset, node.key_size) == key) {
+                return true;
+            }
+            child += node.extent;
+        }
+        return false;
+    }
+
+    /// Parse the entire input as a single document
+    constexpr void parse_document() {
+        if (str.size() > opts.limits.max_bytes) {
+            static_data_error("Input exceeds the size limit");
+        }
+        parse_value('\0');
+        skip_trivia();
+        if (!at_end()) {
+            static_data_error("Trailing characters in JSON data");
+        }
+    }
+};
+
+struct static_sizes {
+    std::size_t nodes = 0;
+    std::size_t pool  = 0;
+};
+
+constexpr static_sizes static_measure(std::string_view str, parse_options opts) {
+    static_parser p{str, opts};
+    p.parse_document();
+    return {p.n_nodes, p.n_pool};
+}
+
+}  // namespace detail
+
+/**
+ * A reference to a value within a static document.
+ */
+class static_value {
+    const static_node* _nodes = nullptr;
+    const char*        _pool  = nullptr;
+    std::size_t        _idx   = 0;
+
+    constexpr const static_node& _node() const noexcept { return _nodes[_idx]; }
+
+    constexpr void _require(static_kind k) const {
+        if (_node().kind != k) {
+            detail::static_data_error("Static JSON5 value accessed as the wrong kind");
+        }
+    }
+
+public:
+    constexpr static_value(const static_node* nodes, const char* pool, std::size_t idx) noexcept
+        : _nodes(nodes)
+        , _pool(pool)
+        , _idx(idx) {}
+
+    constexpr static_kind kind() const noexcept { return _node().kind; }
+
+    constexpr bool is_null() const noexcept { return kind() == static_kind::null; }
+    constexpr bool is_boolean() const noexcept { return kind() == static_kind::boolean; }
+    constexpr bool is_number() const noexcept { return kind() == static_kind::number; }
+    constexpr bool is_string() const noexcept { return kind() == static_kind::string; }
+    constexpr bool is_array() const noexcept { return kind() == static_kind::array; }
+    constexpr bool is_object() const noexcept { return kind() == static_kind::object; }
+
+    constexpr bool as_boolean() const {
+        _require(static_kind::boolean);
+        return _node().boolean;
+    }
+    constexpr double as_number() const {
+        _require(static_kind::number);
+        return _node().number;
+    }
+    constexpr std::string_view as_string() const {
+        _require(static_kind::string);
+        return std::string_view(_pool + _node().str_offset, _node().str_size);
+    }
+
+    /// The key of this value, if it is the value of an object member
+    constexpr std::string_view key() const noexcept {
+        return std::string_view(_pool + _node().key_offset, _node().key_size);
+    }
+
+    /// The number of elements of an array, or members of an object
+    constexpr std::size_t size() const {
+        if (!is_array()) {
+            _require(static_kind::object);
+        }
+        return _node().size;
+    }
+
+    /// Obtain the Nth element of an array or the value of the Nth member of an object
+    constexpr static_value operator[](std::size_t n) const {
+        if (n >= size()) {
+            detail::static_data_error("Static JSON5 index is out of range");
+        }
+        auto child = _idx + 1;
+        for (; n != 0; --n) {
+            child += _nodes[child].extent;
+        }
+        return static_value(_nodes, _pool, child);
+    }
+
+    /// Find the value of the first object member with the given key
+    constexpr std::optional<static_value> find(std::string_view key) const {
+        _require(static_kind::object);
+        auto child = _idx + 1;
+        for (std::size_t n = 0; n != _node().size; ++n) {
+            auto v = static_value(_nodes, _pool, child);
+            if (v.key() == key) {
+                return v;
+            }
+            child += _nodes[child].extent;
+        }
+        return std::nullopt;
+    }
+};
+
+template <std::size_t NNodes, std::size_t NPool>
+struct static_document {
+    std::array<static_node, NNodes> nodes{};
+    std::array<char, NPool>         pool{};
+
+    constexpr static_value root() const noexcept {
+        return static_value(nodes.data(), pool.data(), 0);
+    }
+};
+
+/**
+ * Parse the given string literal at compile time. Invalid input fails the compilation.
+ */
+template <fixed_string Str, parse_options Opts = parse_options{}>
+consteval auto static_parse() {
+    constexpr auto sizes = detail::static_measure(Str.view(), Opts);
+
+    static_document<sizes.nodes, sizes.pool> doc;
+    detail::static_parser                    p{Str.view(), Opts, doc.nodes.data(), doc.pool.data()};
+    p.parse_document();
+    return doc;
+}
+
+}  // namespace json5
+
+#endif
@@ -0,0 +1,216 @@
+#include <json5/static_parse.hpp>
+
+#include <json5/parse_data.hpp>
+
+#include <catch2/catch.hpp>
+
+#if defined(__cpp_consteval)
+
+#include <cmath>
+
+namespace {
+
+constexpr auto config = json5::static_parse<R"(
+    // Embedded configuration
+    {
+        name: 'server',
+        "port": 8080,
+        ratio: 0.75,
+        enabled: true,
+        fallback: null,
+        hosts: ['alpha', "beta", ],
+        limits: {depth: 16, scale: -1.5},
+    }
+)">();
+
+static_assert(config.root().is_object());
+static_assert(config.root().size() == 7);
+static_assert(config.root().find("name")->as_string() == "server");
+static_assert(config.root().find("port")->as_number() == 8080);
+static_assert(config.root().find("ratio")->as_number() == 0.75);
+static_assert(config.root().find("enabled")->as_boolean());
+static_assert(config.root().find("fallback")->is_null());
+static_assert(config.root().find("hosts")->size() == 2);
+static_assert((*config.root().find("hosts"))[1].as_string() == "beta");
+static_assert(!config.root().find("missing").has_value());
+static_assert(config.root()[6].key() == "limits");
+
+}  // namespace
+
+TEST_CASE("Static parse results are usable at runtime") {
+    auto root = config.root();
+    CHECK(root.find("name")->as_string() == "server");
+    auto limits = *root.find("limits");
+    CHECK(limits.find("depth")->as_number() == 16);
+    CHECK_THROWS_AS(root.as_number(), json5::parse_error);
+    CHECK_THROWS_AS(root[7], json5::parse_error);
+}
+
+TEST_CASE("Static parse agrees with parse_data") {
+    constexpr auto doc  = json5::static_parse<R"(['a\'b', "c\nd", 'e\
+f', 1.5, .25, +3, 123456789012, Infinity])">();
+    auto           data = json5::parse_data(R"(['a\'b', "c\nd", 'e\
+f', 1.5, .25, +3, 123456789012, Infinity])");
+    auto           root = doc.root();
+    REQUIRE(root.size() == data.as_array().size());
+    for (std::size_t i = 0; i != root.size(); ++i) {
+        const auto& expect = data.as_array()[i];
+        if (expect.is_string()) {
+            CHECK(root[i].as_string() == expect.as_string());
+        } else {
+            CHECK(root[i].as_number() == expect.as_number());
+        }
+    }
+
+    constexpr auto nan = json5::static_parse<"NaN">();
+    CHECK(std::isnan(nan.root().as_number()));
+}
+
+TEST_CASE("Static parse of UTF-8") {
+    constexpr auto doc = json5::static_parse<"{ünïcödé: 'ßnow ☃', /* ☃ */ x́: 1}">();
+    static_assert(doc.root().find("ünïcödé")->as_string() == "ßnow ☃");
+    static_assert(doc.root().find("x́")->as_number() == 1);
+
+    auto measure = [](std::string_view str) {
+        return json5::detail::static_measure(str, json5::parse_options{});
+    };
+    CHECK_THROWS_AS(measure("'caf\xc3'"), json5::parse_error);
+    CHECK_THROWS_AS(measure("// \xff\n1"), json5::parse_error);
+    CHECK_THROWS_AS(measure("{́x: 1}"), json5::parse_error);
+}
+
+TEST_CASE("Static parse honors parse options") {
+    constexpr auto doc = json5::static_parse<R"({"a": [1, 2]})", json5::json_strict_options>();
+    static_assert(doc.root().find("a")->size() == 2);
+}
+
+TEST_CASE("Static parse rejects invalid input") {
+    // Outside of constant evaluation, the same errors are thrown as exceptions
+    auto measure = [](std::string_view str, json5::parse_options opts = {}) {
+        return json5::detail::static_measure(str, opts);
+    };
+    CHECK(measure("[1, {a: 'b'}]").nodes == 4);
+    CHECK(measure("[1, {a: 'b'}]").pool == 2);
+    CHECK_THROWS_AS(measure("[1, 2"), json5::parse_error);
+    CHECK_THROWS_AS(measure("{a 1}"), json5::parse_error);
+    CHECK_THROWS_AS(measure("{null: 1}"), json5::parse_error);
+    CHECK_THROWS_AS(measure("'unterminated"), json5::parse_error);
+    CHECK_THROWS_AS(measure("[1] 2"), json5::parse_error);
+    CHECK_THROWS_AS(measure("foo"), json5::parse_error);
+    CHECK_THROWS_AS(measure("/* open"), json5::parse_error);
+    CHECK_THROWS_AS(measure("[1,]", json5::json_strict_options), json5::parse_error);
+    CHECK_THROWS_AS(measure("{a: 1}", json5::json_strict_options), json5::parse_error);
+    CHECK_THROWS_AS(measure("// c\n1", json5::json_strict_options), json5::parse_error);
+}
+
+TEST_CASE("Static parse errors match parse_data") {
+    struct error_case {
+        const char*          str;
+        json5::parse_options opts;
+    };
+    const error_case cases[] = {
+        {"[1,]", json5::json_strict_options},
+        {R"({"a": 1,})", json5::json_strict_options},
+        {"{a: 1,,}", {}},
+        {"{,}", {}},
+        {"[1,,]", {}},
+        {"[,]", {}},
+        {"{a: ,}", {}},
+        {",", {}},
+        {"]", {}},
+        {"{1: 2}", {}},
+        {"{[]: 2}", {}},
+        {"{true: 2}", {}},
+        {"{true: 2}", json5::json_strict_options},
+        {"{a: 1}", json5::json_strict_options},
+        {"{a 1}", {}},
+        {"{a: 1 b: 2}", {}},
+        {"[1, 2", {}},
+        {"[", {}},
+        {"[1,", {}},
+        {"[1,", json5::json_strict_options},
+        {"{a: 1", {}},
+        {"{a: 1,", json5::json_strict_options},
+        {"{a:", {}},
+        {"[1] 2", {}},
+    };
+    for (const auto& c : cases) {
+        INFO("Input: " << c.str);
+        std::string runtime_error;
+        try {
+            json5::parse_data(c.str, c.opts);
+        } catch (const json5::parse_error& e) {
+            runtime_error = e.what();
+        }
+        REQUIRE_FALSE(runtime_error.empty());
+        try {
+            json5::detail::static_measure(c.str, c.opts);
+            FAIL("Expected a parse_error");
+        } catch (const json5::parse_error& e) {
+            CHECK_THAT(runtime_error, Catch::Contains(e.what()));
+        }
+    }
+}
+
+TEST_CASE("Static parse keeps the first of duplicate keys") {
+    static constexpr auto doc
+        = json5::static_parse<"{a: 1, b: {c: 'x'}, a: [2, 3], b: 'y', d: 4}">();
+    constexpr auto root = doc.root();
+    static_assert(root.size() == 3);
+    static_assert(root.find("a")->as_number() == 1);
+    static_assert(root.find("b")->find("c")->as_string() == "x");
+    static_assert(root[2].key() == "d");
+    static_assert(root[2].as_number() == 4);
+}
+
+TEST_CASE("Static parse applies parse limits") {
+    auto limited = [](auto set_limit) {
+        json5::parse_options opts;
+        set_limit(opts.limits);
+        return opts;
+    };
+    struct limit_case {
+        const char*          str;
+        json5::parse_options opts;
+    };
+    const limit_case cases[] = {
+        {"[1, 2, 3]", limited([](auto& l) { l.max_bytes = 8; })},
+        {"[[[]]]", limited([](auto& l) { l.max_depth = 2; })},
+        {"'abcd'", limited([](auto& l) { l.max_string_length = 3; })},
+        {"{abcd: 1}", limited([](auto& l) { l.max_string_length = 3; })},
+        {"[1, 2, 3]", limited([](auto& l) { l.max_elements = 2; })},
+        {"{a: 1, a: 2, a: 3}", limited([](auto& l) { l.max_elements = 2; })},
+        {"[1, [2]]", limited([](auto& l) { l.max_nodes = 3; })},
+    };
+    for (const auto& c : cases) {
+        INFO("Input: " << c.str);
+        std::string runtime_error;
+        try {
+            json5::parse_data(c.str, c.opts);
+        } catch (const json5::parse_error& e) {
+            runtime_error = e.what();
+        }
+        REQUIRE_FALSE(runtime_error.empty());
+        try {
+            json5::detail::static_measure(c.str, c.opts);
+            FAIL("Expected a parse_error");
+        } catch (const json5::parse_error& e) {
+            CHECK_THAT(runtime_error, Catch::Contains(e.what()));
+        }
+    }
+
+    // Input that is exactly at the limits is accepted
+    constexpr auto opts = [] {
+        json5::parse_options o;
+        o.limits.max_bytes         = 12;
+        o.limits.max_depth         = 2;
+        o.limits.max_string_length = 3;
+        o.limits.max_elements      = 2;
+        o.limits.max_nodes         = 4;
+        return o;
+    }();
+    static constexpr auto doc = json5::static_parse<"[[1], 'abc']", opts>();
+    static_assert(doc.root()[1].as_string() == "abc");
+}
+
+#endif
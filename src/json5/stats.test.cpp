@@ -0,0 +1,96 @@
+#include <json5/parse_data.hpp>
+#include <json5/parse_many.hpp>
+#include <json5/parse_parallel.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+// Parse statistics are compiled out of the default build. These tests run in builds that
+// define JSON5_ENABLE_STATS for the library and the tests alike (tools/gcc-10-stats.jsonc).
+#if JSON5_ENABLE_STATS
+
+TEST_CASE("Collect parse statistics") {
+    json5::parse_stats   stats;
+    json5::parse_options opts = json5::json5_options;
+    opts.stats                = &stats;
+
+    std::string_view doc = "{a: [1, 2, [3]], 'b': 'str'} // comment";
+    json5::parse_data(doc, opts);
+    CHECK(stats.bytes == doc.size());
+    CHECK(stats.max_depth == 3);
+    CHECK(stats.numbers_parsed == 3);
+    CHECK(stats.strings_unescaped == 2);
+    CHECK(stats.tokens[json5::token::comment] == 1);
+    CHECK(stats.tokens[json5::token::number_literal] == 3);
+    CHECK(stats.allocations == 6);
+}
+
+TEST_CASE("Parse statistics across a rebased buffer") {
+    json5::parse_stats   stats;
+    json5::parse_options opts = json5::json5_options;
+    opts.stats                = &stats;
+
+    std::string   head = "[1, 2";
+    json5::parser p{head, opts};
+    p.next();
+    p.next();
+    // Discard the bytes that have been read, and append the rest of the input
+    const auto  n_discarded = p.offset();
+    std::string tail        = head.substr(n_discarded) + ", 3]";
+    p.rebase(tail, n_discarded);
+    while (p.next().kind != json5::parse_event::eof) {
+    }
+    CHECK(stats.bytes == std::string_view("[1, 2, 3]").size());
+    CHECK(stats.tokens[json5::token::number_literal] == 3);
+}
+
+TEST_CASE("Parallel parse statistics") {
+    std::string str = "[";
+    for (int i = 0; i < 100; ++i) {
+        str += "{id: " + std::to_string(i) + ", tags: ['a', [1]]},";
+    }
+    str += "]";
+
+    json5::parse_stats   serial;
+    json5::parse_stats   parallel;
+    json5::parse_options opts = json5::json5_options;
+    opts.stats                = &serial;
+    json5::parse_data(str, opts);
+    opts.stats = &parallel;
+    json5::parse_data_parallel(str, opts, 4);
+
+    CHECK(parallel.max_depth == serial.max_depth);
+    CHECK(parallel.numbers_parsed == serial.numbers_parsed);
+    CHECK(parallel.strings_unescaped == serial.strings_unescaped);
+    CHECK(parallel.allocations == serial.allocations);
+    CHECK(parallel.tokens[json5::token::number_literal]
+          == serial.tokens[json5::token::number_literal]);
+}
+
+TEST_CASE("Batch parse statistics") {
+    std::vector<std::string> inputs;
+    for (int i = 0; i < 200; ++i) {
+        inputs.push_back("{name: 'pkg-" + std::to_string(i) + "', deps: ['a', 'b']}");
+    }
+
+    json5::parse_stats   serial;
+    json5::parse_stats   batch;
+    json5::parse_options opts = json5::json5_options;
+    opts.stats                = &serial;
+    for (const auto& input : inputs) {
+        json5::parse_data(input, opts);
+    }
+    opts.stats = &batch;
+    json5::parse_many(inputs, opts, 4);
+
+    CHECK(batch.bytes == serial.bytes);
+    CHECK(batch.max_depth == serial.max_depth);
+    CHECK(batch.strings_unescaped == serial.strings_unescaped);
+    CHECK(batch.allocations == serial.allocations);
+    CHECK(batch.tokens[json5::token::string_literal]
+          == serial.tokens[json5::token::string_literal]);
+}
+
+#endif
@@ -0,0 +1,205 @@
+#include "./structure.hpp"
+
+using namespace json5;
+
+namespace {
+
+bool is_space(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * A minimal scanner over the raw bytes of a document. It only needs to know enough to not
+ * be fooled by brackets and commas that appear within strings and comments.
+ */
+struct structure_scanner {
+    std::string_view::iterator it;
+    std::string_view::iterator stop;
+    bool                       saw_comment = false;
+
+    /// Skip whitespace and comments. Returns `false` on an unterminated comment.
+    bool skip_trivia() noexcept {
+        while (it != stop) {
+            if (is_space(*it)) {
+                ++it;
+            } else if (*it == '/' && stop - it > 1 && it[1] == '/') {
+                saw_comment = true;
+                while (it != stop && *it != '\n' && *it != '\r') {
+                    ++it;
+                }
+            } else if (*it == '/' && stop - it > 1 && it[1] == '*') {
+                saw_comment = true;
+                it += 2;
+                while (true) {
+                    if (stop - it < 2) {
+                        return false;
+                    }
+                    if (it[0] == '*' && it[1] == '/') {
+                        it += 2;
+                        break;
+                    }
+                    ++it;
+                }
+            } else {
+                break;
+            }
+        }
+        return true;
+    }
+
+    /// Skip a string literal starting at the opening quote. Returns `false` if unterminated.
+    bool skip_string() noexcept {
+        const char quote = *it++;
+        while (it != stop) {
+            const char c = *it++;
+            if (c == '\\') {
+                if (it == stop) {
+                    return false;
+                }
+                // An escaped CRLF is a single line continuation
+                if (*it++ == '\r' && it != stop && *it == '\n') {
+                    ++it;
+                }
+            } else if (c == quote) {
+                return true;
+            } else if (c == '\n' || c == '\r') {
+                return false;
+            }
+        }
+        return false;
+    }
+};
+
+std::string_view trim_range(std::string_view::iterator first, std::string_view::iterator last) {
+    while (first != last && is_space(*first)) {
+        ++first;
+    }
+    while (last != first && is_space(*std::prev(last))) {
+        --last;
+    }
+    return std::string_view(&*first, static_cast<std::size_t>(last - first));
+}
+
+}  // namespace
+
+std::optional<std::vector<std::string_view>>
+json5::detail::split_toplevel_array(std::string_view str, parse_options opts) {
+    structure_scanner scan{str.begin(), str.end()};
+    if (!scan.skip_trivia() || scan.it == scan.stop || *scan.it != '[') {
+        return std::nullopt;
+    }
+    ++scan.it;
+
+    std::vector<std::string_view> ret;
+    std::size_t                   depth      = 1;
+    auto                          elem_begin = scan.it;
+    // Whether anything other than whitespace and comments appears in the current element
+    bool elem_has_content = false;
+    while (true) {
+        if (!scan.skip_trivia() || scan.it == scan.stop) {
+            return std::nullopt;
+        }
+        const char c = *scan.it;
+        if (depth == 1 && (c == ',' || c == ']')) {
+            if (!elem_has_content) {
+                // An empty element is only permitted as a trailing comma
+                const bool is_trailing = c == ']' && !ret.empty()
+                    && opts.trailing_commas == toggle::on;
+                const bool is_empty_array = c == ']' && ret.empty();
+                if (!is_trailing && !is_empty_array) {
+                    return std::nullopt;
+                }
+            } else {
+                ret.push_back(trim_range(elem_begin, scan.it));
+            }
+            ++scan.it;
+            elem_begin       = scan.it;
+            elem_has_content = false;
+            if (c == ']') {
+                break;
+            }
+            continue;
+        }
+        elem_has_content = true;
+        if (c == '\'' || c == '"') {
+            if (!scan.skip_string()) {
+                return std::nullopt;
+            }
+            continue;
+        }
+        if (c == '[' || c == '{') {
+            ++depth;
+            // Keep the nesting limit of the parser: The top-level array counts as one level
+            if (depth > 1024) {
+                return std::nullopt;
+            }
+        } else if ((c == ']' || c == '}') && depth > 1) {
+            --depth;
+        } else if (c == '}') {
+            return std::nullopt;
+        }
+        ++scan.it;
+    }
+
+    // Only trivia may follow the closing bracket
+    if (!scan.skip_trivia() || scan.it != scan.stop
+        || (scan.saw_comment && opts.c_comments == toggle::off)) {
+        return std::nullopt;
+    }
+    return ret;
+}
+
+bool json5::detail::count_container_sizes(std::string_view          str,
+                                          std::vector<std::size_t>& sizes,
+                                          std::size_t               max_containers) {
+    struct open_container {
+        std::size_t index;
+        // Whether anything other than whitespace and comments appears in the current element
+        bool elem_has_content;
+    };
+
+    std::vector<open_container> stack;
+    structure_scanner           scan{str.begin(), str.end()};
+    auto                        mark_content = [&] {
+        if (!stack.empty()) {
+            stack.back().elem_has_content = true;
+        }
+    };
+
+    sizes.clear();
+    while (scan.skip_trivia() && scan.it != scan.stop) {
+        const char c = *scan.it;
+        if (c == '\'' || c == '"') {
+            mark_content();
+            if (!scan.skip_string()) {
+                break;
+            }
+            continue;
+        }
+        if (c == '[' || c == '{') {
+            if (sizes.size() == max_containers) {
+                return false;
+            }
+            mark_content();
+            stack.push_back({sizes.size(), false});
+            sizes.push_back(0);
+        } else if (c == ']' || c == '}') {
+            if (stack.empty()) {
+                break;
+            }
+            if (stack.back().elem_has_content) {
+                ++sizes[stack.back().index];
+            }
+            stack.pop_back();
+        } else if (c == ',' && !stack.empty()) {
+            if (stack.back().elem_has_content) {
+                ++sizes[stack.back().index];
+            }
+            stack.back().elem_has_content = false;
+        } else {
+            mark_content();
+        }
+        ++scan.it;
+    }
+    return true;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <json5/parse.hpp>
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace json5::detail {
+
+/**
+ * Quick structural scans of a JSON5 document. These only understand brackets, strings, and
+ * comments, and do not validate the document. They are much cheaper than tokenizing, and
+ * are used to plan work before the actual parse.
+ */
+
+/**
+ * Find the source ranges of the elements of a top-level array. Returns `nullopt` if the
+ * document is not a top-level array, or if anything looks unusual. In that case the caller
+ * should fall back to a regular parse, which will also generate any appropriate error.
+ */
+std::optional<std::vector<std::string_view>> split_toplevel_array(std::string_view str,
+                                                                  parse_options    opts);
+
+/**
+ * Count the elements of each array and the members of each object in the document. The
+ * counts replace the contents of `sizes`, in the order in which the arrays and objects are
+ * opened. The counts are meaningless for an invalid document.
+ *
+ * The scan stops and returns `false` if the document has more than `max_containers` arrays
+ * and objects. `sizes` then only holds counts for some of them, and the counts of those
+ * that were still open are too low.
+ */
+bool count_container_sizes(std::string_view          str,
+                           std::vector<std::size_t>& sizes,
+                           std::size_t               max_containers = SIZE_MAX);
+
+}  // namespace json5::detail
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace json5::detail {
+
+/**
+ * Threads that are joined when the group is destroyed. Threads that were already started
+ * are therefore waited on, rather than terminating the program, if starting another one
+ * throws.
+ */
+class thread_group {
+    std::vector<std::thread> _threads;
+
+public:
+    thread_group() = default;
+    thread_group(const thread_group&) = delete;
+    thread_group& operator=(const thread_group&) = delete;
+
+    ~thread_group() { join(); }
+
+    /// Start a new thread that invokes `fn` with the given arguments
+    template <typename Func, typename... Args>
+    void spawn(Func&& fn, Args&&... args) {
+        _threads.emplace_back(std::forward<Func>(fn), std::forward<Args>(args)...);
+    }
+
+    /// Wait for every thread to finish
+    void join() {
+        for (auto& t : _threads) {
+            t.join();
+        }
+        _threads.clear();
+    }
+};
+
+}  // namespace json5::detail
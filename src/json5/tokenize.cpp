@@ -1,7 +1,9 @@
 #include <json5/tokenize.hpp>
 
+#include <json5/unicode.hpp>
+
 #include <cassert>
-#include <cctype>
+#include <utility>
 
 using namespace json5;
 
@@ -19,8 +21,8 @@ using namespace json5;
  * For reference, use the https://spec.json5.org/#lexical-grammar page.
  *
  * The following features are known to be missing:
- *  - Using std::isspace for white-space checks is probably missing a few.
- *  - Identifiers may use non-ASCII characters. This only handles the basics.
+ *  - Only ASCII white-space is recognized.
+ *  - Identifiers may not contain `\u` escape sequences.
  *  - Missing negative and positive `Infinity` and `NaN` literals.
  *  - Doesn't respect line separator (U-2028) or paragraph separator (U-2029)
  *    as line endings.
@@ -29,10 +31,16 @@ using namespace json5;
 
 namespace {
 
-bool is_space(char c) noexcept { return std::isspace(c); }
-bool is_ident_first(char c) noexcept { return std::isalpha(c) || c == '_' || c == '$'; }
-bool is_ident_char(char c) noexcept { return is_ident_first(c) || std::isdigit(c); }
+// These are ASCII-only and independent of the locale. Non-ASCII identifier characters are
+// checked against the Unicode tables.
+bool is_space(char c) noexcept { return c == ' ' || (c >= '\t' && c <= '\r'); }
+bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+bool is_ident_first(char c) noexcept {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$';
+}
+bool is_ident_char(char c) noexcept { return is_ident_first(c) || is_digit(c); }
 bool is_line_term(char c) { return c == '\n' || c == '\r'; }
+bool is_ascii(char c) noexcept { return static_cast<unsigned char>(c) < 0x80; }
 
 }  // namespace
 
@@ -55,9 +63,31 @@ void tokenizer::_take(std::size_t n) noexcept {
     }
 }
 
+bool tokenizer::_take_utf8() noexcept {
+    char32_t   cp  = 0;
+    const auto len = detail::utf8_decode(&*_head, _full_buffer.data() + _full_buffer.size(), cp);
+    if (len == 0) {
+        _take_plain(1);
+        return false;
+    }
+    _take_plain(static_cast<std::size_t>(len));
+    return true;
+}
+
 void tokenizer::_adv_ident() noexcept {
-    while (_head != _full_buffer.end() && is_ident_char(_peek(0))) {
-        _take(1);
+    const auto end = _full_buffer.data() + _full_buffer.size();
+    while (_head != _full_buffer.end()) {
+        _mark_resume(scan_phase::identifier);
+        if (is_ident_char(_peek(0))) {
+            _take(1);
+            continue;
+        }
+        char32_t   cp  = 0;
+        const auto len = is_ascii(_peek(0)) ? 0 : detail::utf8_decode(&*_head, end, cp);
+        if (len == 0 || !detail::is_unicode_id_continue(cp)) {
+            break;
+        }
+        _take_plain(static_cast<std::size_t>(len));
     }
 
     _current_kind = token::identifier;
@@ -72,79 +102,128 @@ void tokenizer::_adv_ident() noexcept {
 }
 
 void tokenizer::_adv_line_comment() noexcept {
+    const auto end = _full_buffer.data() + _full_buffer.size();
+    _current_kind  = token::comment;
     while (_head != _full_buffer.end() && !is_line_term(*_head)) {
-        _take(1);
+        _mark_resume(scan_phase::line_comment);
+        _take_run(detail::ascii_run(&*_head, end, '\n', '\r', '\n', '\r'),
+                  scan_phase::line_comment);
+        if (_head == _full_buffer.end() || is_line_term(*_head)) {
+            break;
+        }
+        if (!is_ascii(*_head)) {
+            if (!_take_utf8()) {
+                _current_kind = token::invalid_utf8;
+                return;
+            }
+        } else {
+            _take(1);
+        }
     }
-    _current_kind = token::comment;
 }
 
 void tokenizer::_adv_block_comment() noexcept {
-    bool terminated = false;
+    const auto end        = _full_buffer.data() + _full_buffer.size();
+    bool       terminated = false;
     while (_head != _full_buffer.end()) {
+        _mark_resume(scan_phase::block_comment);
         if (_peek(0) == '*' && _peek(1) == '/') {
             _take(2);
             terminated = true;
             break;
         }
+        if (!is_ascii(*_head)) {
+            if (!_take_utf8()) {
+                _current_kind = token::invalid_utf8;
+                return;
+            }
+            continue;
+        }
         _take(1);
+        _take_run(detail::ascii_run(&*_head, end, '*', '\n', '*', '\n'),
+                  scan_phase::block_comment);
     }
     _current_kind = terminated ? token::comment : token::unterm_comment;
 }
 
-void tokenizer::advance() noexcept {
-    // Tokenize a string
-    auto adv_string = [this](char quote) {
-        bool escaped = false;
-        while (_head != _full_buffer.end()) {
-            if (escaped) {
-                // Take the character, no matter what it is
-                _take(1);
-                escaped = false;
-            } else if (*_head == '\\') {
-                _take(1);
-                escaped = true;
-            } else if (*_head == quote) {
-                // Closed quote!
-                break;
-            } else if (is_line_term(*_head)) {
-                // BAD! Embedded newline
+void tokenizer::_adv_string(char quote) noexcept {
+    const auto end     = _full_buffer.data() + _full_buffer.size();
+    bool       escaped = false;
+    while (_head != _full_buffer.end()) {
+        if (!escaped) {
+            _mark_resume(scan_phase::string);
+            // Skip plain ASCII a word at a time
+            _take_run(detail::ascii_run(&*_head, end, quote, '\\', '\n', '\r'),
+                      scan_phase::string);
+            if (_head == _full_buffer.end()) {
                 break;
-            } else {
-                // A string character
-                _take(1);
             }
         }
-        if (_head == _full_buffer.end() || is_line_term(*_head)) {
-            // We reached the end of the string without a closing quote.
-            _current_kind = token::unterm_string;
+        if (!is_ascii(*_head)) {
+            if (!_take_utf8()) {
+                _current_kind = token::invalid_utf8;
+                return;
+            }
+            escaped = false;
+        } else if (escaped) {
+            // Take the character, no matter what it is. An escaped CRLF is taken whole.
+            const bool crlf = *_head == '\r' && _peek(1) == '\n';
+            _take(crlf ? 2 : 1);
+            escaped = false;
+        } else if (*_head == '\\') {
+            _take(1);
+            escaped = true;
+        } else if (*_head == quote) {
+            // Closed quote!
+            break;
+        } else if (is_line_term(*_head)) {
+            // BAD! Embedded newline
+            break;
         } else {
+            // A string character
             _take(1);
-            _current_kind = token::string_literal;
         }
-    };
+    }
+    if (_head == _full_buffer.end() || is_line_term(*_head)) {
+        // We reached the end of the string without a closing quote.
+        _current_kind = token::unterm_string;
+    } else {
+        _take(1);
+        _current_kind = token::string_literal;
+    }
+}
 
-    // Tokenize a number literal.
-    auto adv_number = [&] {
-        _current_kind = token::number_literal;
-        if (*_head == '.') {
-            // Leading off with a dot *requires* that we have trailing decimal digits
-            if (!std::isdigit(_peek(1))) {
-                _take(1);
-                _current_kind = token::invalid;
-                return;
-            }
-        }
-        while (_head != _full_buffer.end() && std::isdigit(*_head)) {
+void tokenizer::_adv_number() noexcept {
+    _current_kind = token::number_literal;
+    if (*_head == '.') {
+        // Leading off with a dot *requires* that we have trailing decimal digits
+        if (!is_digit(_peek(1))) {
             _take(1);
+            _current_kind = token::invalid;
+            return;
         }
-        if (_head != _full_buffer.end() && *_head == '.' && std::isdigit(_peek(1))) {
+    }
+    _adv_number_digits(false);
+}
+
+void tokenizer::_adv_number_digits(bool fraction) noexcept {
+    if (!fraction) {
+        while (_head != _full_buffer.end() && is_digit(*_head)) {
+            _mark_resume(scan_phase::number_digits);
             _take(1);
-            while (_head != _full_buffer.end() && std::isdigit(*_head)) {
-                _take(1);
-            }
         }
-    };
+        if (_head == _full_buffer.end() || *_head != '.' || !is_digit(_peek(1))) {
+            return;
+        }
+        _take(1);
+    }
+    while (_head != _full_buffer.end() && is_digit(*_head)) {
+        _mark_resume(scan_phase::number_fraction);
+        _take(1);
+    }
+}
 
+void tokenizer::advance() noexcept {
     // We should not be called a second time after having passed the EOF
     assert(!_done && "advance() called on finished tokenizer");
 
@@ -154,9 +233,10 @@ void tokenizer::advance() noexcept {
     }
 
     // Reset attributes for new token
-    _tail    = _head;
-    _line_no = _next_line_no;
-    _column  = _next_column;
+    _tail         = _head;
+    _line_no      = _next_line_no;
+    _column       = _next_column;
+    _resume_phase = scan_phase::none;
 
     // Check if we've reached the end of the input
     if (_head == _full_buffer.end()) {
@@ -210,6 +290,21 @@ void tokenizer::advance() noexcept {
     if (is_ident_first(c)) {
         // We're seeing an identifier
         _adv_ident();
+    } else if (!is_ascii(c)) {
+        // Non-ASCII characters may only begin an identifier
+        const auto end = _full_buffer.data() + _full_buffer.size();
+        char32_t   cp  = 0;
+        const auto len = detail::utf8_decode(&*_head, end, cp);
+        if (len == 0) {
+            _take(1);
+            _current_kind = token::invalid_utf8;
+        } else if (detail::is_unicode_id_start(cp)) {
+            _take_plain(static_cast<std::size_t>(len));
+            _adv_ident();
+        } else {
+            _take_plain(static_cast<std::size_t>(len));
+            _current_kind = token::invalid;
+        }
     } else if (c == '/' && _peek(1) == '/') {
         // Consume a line-comment
         _adv_line_comment();
@@ -219,8 +314,8 @@ void tokenizer::advance() noexcept {
     } else if (c == '\'' || c == '"') {
         // This is a string literal
         _take(1);
-        adv_string(c);
-    } else if (std::isdigit(c) || c == '.' || c == '+' || c == '-') {
+        _adv_string(c);
+    } else if (is_digit(c) || c == '.' || c == '+' || c == '-') {
         // This is a number literal
         if (c == '+' || c == '-') {
             _take(1);
@@ -228,13 +323,50 @@ void tokenizer::advance() noexcept {
                 // A lone `+` or `-` is no good!
                 _current_kind = token::invalid;
             } else {
-                adv_number();
+                _adv_number();
             }
         } else {
-            adv_number();
+            _adv_number();
         }
     } else {
         _current_kind = token::invalid;
         _take(1);
     }
-}
\ No newline at end of file
+}
+
+void tokenizer::rescan() noexcept {
+    const auto phase = std::exchange(_resume_phase, scan_phase::none);
+    if (phase == scan_phase::none) {
+        // Scan the whole token again. Don't let an EOF token count as having been yielded.
+        _head          = _tail;
+        _next_line_no  = _line_no;
+        _next_column   = _column;
+        _current_kind  = token::invalid;
+        advance();
+        return;
+    }
+    _head         = _full_buffer.begin() + static_cast<std::ptrdiff_t>(_resume_offset);
+    _next_line_no = _resume_line_no;
+    _next_column  = _resume_column;
+    switch (phase) {
+    case scan_phase::string:
+        _adv_string(*_tail);
+        break;
+    case scan_phase::line_comment:
+        _adv_line_comment();
+        break;
+    case scan_phase::block_comment:
+        _adv_block_comment();
+        break;
+    case scan_phase::identifier:
+        _adv_ident();
+        break;
+    case scan_phase::number_digits:
+    case scan_phase::number_fraction:
+        _current_kind = token::number_literal;
+        _adv_number_digits(phase == scan_phase::number_fraction);
+        break;
+    case scan_phase::none:
+        break;
+    }
+}
@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <cctype>
+#include <cstddef>
 #include <string_view>
 
 namespace json5 {
@@ -17,6 +18,7 @@ struct token {
         invalid,
         unterm_string,
         unterm_comment,
+        invalid_utf8,
 
         comment,
         identifier,
@@ -54,11 +56,65 @@ class tokenizer {
     std::string_view::iterator _tail         = _full_buffer.begin();
     std::string_view::iterator _head         = _tail;
 
+    /// The loop of a token's scan that a resume point was recorded in
+    enum class scan_phase : unsigned char {
+        none,
+        string,
+        line_comment,
+        block_comment,
+        identifier,
+        number_digits,
+        number_fraction,
+    };
+
+    /**
+     * A point within the current token, close to the end of the buffer, from which `rescan()`
+     * can continue the scan of the token. An iteration of a scan loop that looks past the end
+     * of the buffer is always the last, so nothing before the start of an iteration depends
+     * on the bytes that follow the buffer.
+     */
+    scan_phase  _resume_phase   = scan_phase::none;
+    std::size_t _resume_offset  = 0;
+    int         _resume_line_no = 0;
+    int         _resume_column  = 0;
+
+    /**
+     * Record the position `back` bytes before `_head` as the resume point, if it is close to
+     * the end of the buffer. The scan loops call this at the start of each iteration.
+     */
+    void _mark_resume(scan_phase phase, std::size_t back = 0) noexcept {
+        const auto remaining = static_cast<std::size_t>(_full_buffer.end() - _head) + back;
+        if (remaining <= 16) {
+            _resume_phase   = phase;
+            _resume_offset  = offset() - back;
+            _resume_line_no = _next_line_no;
+            _resume_column  = _next_column - static_cast<int>(back);
+        }
+    }
+    /// Take a run of `n` plain bytes within a token, which contain no newlines
+    void _take_run(std::size_t n, scan_phase phase) noexcept {
+        _take_plain(n);
+        if (n != 0) {
+            // Any point within the run is as good as the start of an iteration
+            _mark_resume(phase, _head == _full_buffer.end() ? 1 : 0);
+        }
+    }
+
     char _peek(int n) const noexcept;
     void _take(std::size_t n) noexcept;
+    /// Take `n` bytes that are known to contain no newlines
+    void _take_plain(std::size_t n) noexcept {
+        _head += static_cast<std::ptrdiff_t>(n);
+        _next_column += static_cast<int>(n);
+    }
+    /// Take a UTF-8 sequence. Returns `false` and takes one byte if it is invalid.
+    bool _take_utf8() noexcept;
     void _adv_ident() noexcept;
     void _adv_line_comment() noexcept;
     void _adv_block_comment() noexcept;
+    void _adv_string(char quote) noexcept;
+    void _adv_number() noexcept;
+    void _adv_number_digits(bool fraction) noexcept;
 
 public:
     explicit tokenizer(std::string_view buf)
@@ -94,6 +150,13 @@ public:
 
     void advance() noexcept;
 
+    /**
+     * Scan the current token again, after `rebase()` has extended the buffer. If the token
+     * was long and reached close to the end of the old buffer, the scan continues from there
+     * instead of from the start of the token.
+     */
+    void rescan() noexcept;
+
     bool done() const noexcept { return _done; }
 
     std::string_view current_string() const noexcept {
@@ -103,10 +166,36 @@ public:
         return std::string_view(&*_tail, static_cast<std::string_view::size_type>(_head - _tail));
     }
     token::kind_t current_kind() const noexcept { return _current_kind; }
+    /// The offset in the input of the end of the current token
+    std::size_t offset() const noexcept {
+        return static_cast<std::size_t>(_head - _full_buffer.begin());
+    }
+    /// The size of the input buffer
+    std::size_t size() const noexcept { return _full_buffer.size(); }
     token current() const noexcept { return {current_string(), _line_no, _column, current_kind()}; }
 
     token eof_at_current() const noexcept { return {"", _line_no, _column, token::eof}; }
 
+    /**
+     * Point the tokenizer at a new buffer holding the same input as the current buffer, but
+     * with more bytes appended and with the first `n_discarded` bytes removed. The number of
+     * discarded bytes must not exceed `offset()`. The spelling of the current token is not
+     * preserved.
+     */
+    void rebase(std::string_view buf, std::size_t n_discarded) noexcept {
+        assert(n_discarded <= offset());
+        const auto head_off = offset() - n_discarded;
+        const auto tail_off = static_cast<std::size_t>(_tail - _full_buffer.begin());
+        _full_buffer        = buf;
+        _head               = buf.begin() + head_off;
+        _tail = tail_off < n_discarded ? _head : buf.begin() + (tail_off - n_discarded);
+        if (_resume_offset < n_discarded) {
+            _resume_phase = scan_phase::none;
+        } else {
+            _resume_offset -= n_discarded;
+        }
+    }
+
     token_iterator begin() noexcept {
         advance();
         return token_iterator{*this};
@@ -113,4 +113,80 @@ TEST_CASE("Tokenize numbers") {
     check_tokenize("1.2", {{tk::number_literal, "1.2"}});
     check_tokenize(".2", {{tk::number_literal, ".2"}});
     check_tokenize("-2", {{tk::number_literal, "-2"}});
-}
\ No newline at end of file
+}
+
+TEST_CASE("Tokenize UTF-8") {
+    check_tokenize("ünïcödé café_2 ℵx $ä",
+                   {
+                       {tk::identifier, "ünïcödé"},
+                       {tk::identifier, "café_2"},
+                       {tk::identifier, "ℵx"},
+                       {tk::identifier, "$ä"},
+                   });
+    check_tokenize("'a long string with ünïcödé in the middle of it' // ☃ comment",
+                   {
+                       {tk::string_literal, "'a long string with ünïcödé in the middle of it'"},
+                       {tk::comment, "// ☃ comment"},
+                   });
+    check_tokenize("/* ☃ */ '\\☃'", {{tk::comment, "/* ☃ */"}, {tk::string_literal, "'\\☃'"}});
+    // Combining marks and digits may not begin an identifier
+    check_tokenize("́x", {{tk::invalid, "́"}, {tk::identifier, "x"}});
+    check_tokenize("x́", {{tk::identifier, "x́"}});
+
+    // Malformed UTF-8
+    check_tokenize("'abcdefgh\xff'",
+                   {{tk::invalid_utf8, "'abcdefgh\xff"}, {tk::unterm_string, "'"}});
+    check_tokenize("\xc3(", {{tk::invalid_utf8, "\xc3"}, {tk::invalid, "("}});
+    check_tokenize("// \xed\xa0 x",
+                   {
+                       {tk::invalid_utf8, "// \xed"},
+                       {tk::invalid_utf8, "\xa0"},
+                       {tk::identifier, "x"},
+                   });
+    check_tokenize("/* \xc0\xaf */ x",
+                   {
+                       {tk::invalid_utf8, "/* \xc0"},
+                       {tk::invalid_utf8, "\xaf"},
+                       {tk::invalid, "*"},
+                       {tk::invalid, "/"},
+                       {tk::identifier, "x"},
+                   });
+}
+
+TEST_CASE("Continue a token after the buffer is extended") {
+    std::string_view inputs[] = {
+        "'a string with \\'escaped\\' quotes, \\\\\\\\ backslashes, an escaped \\\r\n newline, "
+        "and ünïcödé' x",
+        "\"a double-quoted string with 'single' quotes\" x",
+        "'a string that is cut short by a newline\n' x",
+        "'a string with \xff invalid UTF-8 in the middle of it' x",
+        "/* a block comment ** with * stars / and slashes\nover ☃ several\nlines **/ x",
+        "// a line comment that mentions ünïcödé\nx",
+        "identifier_with_ünïcödé_and_digits_0123456789 x",
+        "-12345678901234567890.12345678901234567890 x",
+        "12345678901234567890. x",
+    };
+    for (auto input : inputs) {
+        INFO("Input: " << input);
+        // Extend the buffer one byte at a time. Scanning the first token again must give the
+        // same token as scanning the extended buffer from the start.
+        json5::tokenizer toks(input.substr(0, 1));
+        toks.advance();
+        for (std::size_t len = 2; len <= input.size(); ++len) {
+            const auto       buf = input.substr(0, len);
+            json5::tokenizer fresh(buf);
+            fresh.advance();
+            toks.rebase(buf, 0);
+            toks.rescan();
+            INFO("Length: " << len);
+            check_is(toks.current(), fresh.current().kind, fresh.current().spelling);
+            // The token that follows is where a fresh scan puts it
+            auto next = toks;
+            next.advance();
+            fresh.advance();
+            check_is(next.current(), fresh.current().kind, fresh.current().spelling);
+            CHECK(next.current().line == fresh.current().line);
+            CHECK(next.current().column == fresh.current().column);
+        }
+    }
+}
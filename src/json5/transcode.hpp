@@ -0,0 +1,279 @@
+#pragma once
+
+#include <json5/parse.hpp>
+#include <json5/parse_data.hpp>
+
+#include <bitset>
+#include <cctype>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+namespace json5 {
+
+/**
+ * How `Infinity` and `NaN`, which have no representation in JSON, should be transcoded.
+ */
+enum class nonfinite_policy {
+    /// Throw a `parse_error`
+    error,
+    /// Emit `null`
+    null,
+    /// Emit the spelling as a string, e.g. `"Infinity"`
+    string,
+};
+
+struct transcode_options {
+    nonfinite_policy nonfinite = nonfinite_policy::error;
+};
+
+namespace detail {
+
+/**
+ * Streaming JSON5-to-JSON transcoder. This consumes parser events and writes minified
+ * strict JSON to an output iterator as each event arrives. No data tree is constructed.
+ *
+ * Like the parser, the only state retained is a fixed bitset that tracks whether each
+ * nesting level has seen its first element yet.
+ */
+template <typename Out>
+class json_transcoder {
+    Out               _out;
+    transcode_options _topts;
+
+    std::bitset<1024> _has_elem;
+    std::size_t       _depth     = 0;
+    bool              _after_key = false;
+
+    void _put(char c) { *_out++ = c; }
+    void _put(std::string_view s) {
+        for (char c : s) {
+            _put(c);
+        }
+    }
+
+    void _put_hex_escape(unsigned char c) {
+        constexpr std::string_view digits = "0123456789abcdef";
+        _put("\\u00");
+        _put(digits[c >> 4]);
+        _put(digits[c & 0xf]);
+    }
+
+    /// Emit a comma if this is not the first element at the current nesting level
+    void _separate() {
+        if (_after_key) {
+            // Object values directly follow their key
+            _after_key = false;
+            return;
+        }
+        if (_depth != 0) {
+            if (_has_elem[_depth - 1]) {
+                _put(',');
+            }
+            _has_elem[_depth - 1] = true;
+        }
+    }
+
+    /// Re-emit a JSON5 string literal token as a double-quoted JSON string
+    void _put_string(const token& tok) {
+        const auto spelling = tok.spelling;
+        const auto inner    = spelling.substr(1, spelling.size() - 2);
+        _put('"');
+        for (auto it = inner.begin(); it != inner.end(); ++it) {
+            const char c = *it;
+            if (c == '\\') {
+                ++it;
+                const char esc = *it;
+                switch (esc) {
+                case '"':
+                case '\\':
+                case '/':
+                case 'b':
+                case 'f':
+                case 'n':
+                case 'r':
+                case 't':
+                case 'u':
+                    // Valid in JSON as-is
+                    _put('\\');
+                    _put(esc);
+                    break;
+                case '\r':
+                    // A CRLF line terminator is continued as a whole
+                    if (std::next(it) != inner.end() && it[1] == '\n') {
+                        ++it;
+                    }
+                    [[fallthrough]];
+                case '\n':
+                    // Escaped newline is a line continuation: Nothing is emitted
+                    break;
+                case 'v':
+                    _put_hex_escape('\v');
+                    break;
+                case '0':
+                    _put_hex_escape('\0');
+                    break;
+                case 'x':
+                    if (inner.end() - it < 3 || !std::isxdigit(static_cast<unsigned char>(it[1]))
+                        || !std::isxdigit(static_cast<unsigned char>(it[2]))) {
+                        throw_error("Invalid `\\x` escape sequence in string", tok);
+                    }
+                    _put("\\u00");
+                    _put(*++it);
+                    _put(*++it);
+                    break;
+                default:
+                    // Any other escaped character stands for itself
+                    _put(esc);
+                    break;
+                }
+            } else if (c == '"') {
+                _put("\\\"");
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                _put_hex_escape(static_cast<unsigned char>(c));
+            } else {
+                _put(c);
+            }
+        }
+        _put('"');
+    }
+
+    /// Re-emit a JSON5 number literal token as a JSON number
+    void _put_number(const token& tok) {
+        auto spelling = tok.spelling;
+        if (spelling == "Infinity" || spelling == "NaN") {
+            switch (_topts.nonfinite) {
+            case nonfinite_policy::error:
+                throw_error("Non-finite numbers cannot be represented in JSON", tok);
+            case nonfinite_policy::null:
+                _put("null");
+                return;
+            case nonfinite_policy::string:
+                _put('"');
+                _put(spelling);
+                _put('"');
+                return;
+            }
+        }
+        if (spelling.front() == '+') {
+            spelling.remove_prefix(1);
+        } else if (spelling.front() == '-') {
+            _put('-');
+            spelling.remove_prefix(1);
+        }
+        if (spelling.empty()) {
+            throw_error("Invalid number literal", tok);
+        }
+        // JSON does not permit leading zeros
+        while (spelling.size() > 1 && spelling[0] == '0' && spelling[1] != '.') {
+            spelling.remove_prefix(1);
+        }
+        // JSON requires an integer part
+        if (spelling.front() == '.') {
+            _put('0');
+        }
+        _put(spelling);
+    }
+
+public:
+    json_transcoder(Out out, transcode_options topts)
+        : _out(out)
+        , _topts(topts) {}
+
+    /// Transcode the single JSON5 value from the given parser
+    Out run(parser& p) {
+        using pek          = parse_event::kind_t;
+        bool seen_toplevel = false;
+        auto ev            = p.next();
+        for (; ev.kind != pek::eof; ev = p.next()) {
+            const bool is_value_start = ev.kind != pek::array_end && ev.kind != pek::object_end
+                && ev.kind != pek::object_key && ev.kind != pek::invalid;
+            if (_depth == 0 && is_value_start) {
+                if (seen_toplevel) {
+                    throw_error("Trailing characters in JSON data", ev.token);
+                }
+                seen_toplevel = true;
+            }
+            switch (ev.kind) {
+            case pek::null_literal:
+            case pek::boolean_literal:
+                _separate();
+                _put(ev.token.spelling);
+                break;
+            case pek::number_literal:
+                _separate();
+                _put_number(ev.token);
+                break;
+            case pek::string_literal:
+                _separate();
+                _put_string(ev.token);
+                break;
+            case pek::array_begin:
+            case pek::object_begin:
+                _separate();
+                _put(ev.kind == pek::array_begin ? '[' : '{');
+                _has_elem[_depth] = false;
+                ++_depth;
+                break;
+            case pek::array_end:
+            case pek::object_end:
+                --_depth;
+                _put(ev.kind == pek::array_end ? ']' : '}');
+                break;
+            case pek::object_key:
+                _separate();
+                if (ev.token.kind == token::identifier) {
+                    _put('"');
+                    _put(ev.token.spelling);
+                    _put('"');
+                } else {
+                    _put_string(ev.token);
+                }
+                _put(':');
+                _after_key = true;
+                break;
+            case pek::invalid:
+                throw_error(p.error_message(), ev.token);
+            case pek::comment:
+            case pek::eof:
+                break;
+            }
+        }
+        if (!seen_toplevel) {
+            throw_error("Unexpected end-of-input", ev.token);
+        }
+        return _out;
+    }
+};
+
+}  // namespace detail
+
+/**
+ * Transcode a JSON5 document to minified JSON, writing the result to the given output
+ * iterator. Comments are dropped, identifier keys are quoted, strings are re-quoted with
+ * double quotes, and numbers are rewritten in JSON form. Throws `parse_error` on invalid
+ * input. Output may already have been written when an error is thrown.
+ */
+template <typename Out>
+Out transcode_json(std::string_view str, Out out, parse_options opts, transcode_options topts) {
+    parser p{str, opts};
+    return detail::json_transcoder<Out>(out, topts).run(p);
+}
+
+inline std::string
+transcode_json(std::string_view str, parse_options opts, transcode_options topts) {
+    std::string ret;
+    ret.reserve(str.size());
+    transcode_json(str, std::back_inserter(ret), opts, topts);
+    return ret;
+}
+
+inline std::string transcode_json(std::string_view str, parse_options opts) {
+    return transcode_json(str, opts, transcode_options{});
+}
+
+inline std::string transcode_json(std::string_view str) {
+    return transcode_json(str, parse_options{});
+}
+
+}  // namespace json5
@@ -0,0 +1,54 @@
+#include <json5/transcode.hpp>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Transcode JSON5 to JSON") {
+    CHECK(json5::transcode_json("null") == "null");
+    CHECK(json5::transcode_json(" [ 1 , 2 , ] ") == "[1,2]");
+    CHECK(json5::transcode_json("{foo: 'bar', /* comment */ 'baz': [true, false],}")
+          == R"({"foo":"bar","baz":[true,false]})");
+    CHECK(json5::transcode_json("[[], {}, [[]], {a: {}}]") == R"([[],{},[[]],{"a":{}}])");
+    CHECK(json5::transcode_json("// leading comment\n{\n  a: 1, // one\n  b: 2\n}")
+          == R"({"a":1,"b":2})");
+}
+
+TEST_CASE("Transcode strings") {
+    CHECK(json5::transcode_json(R"('single "quoted"')") == R"("single \"quoted\"")");
+    CHECK(json5::transcode_json(R"('it\'s')") == R"("it's")");
+    CHECK(json5::transcode_json("'line \\\ncontinued'") == R"("line continued")");
+    CHECK(json5::transcode_json("'line \\\rcontinued'") == R"("line continued")");
+    CHECK(json5::transcode_json("'line \\\r\ncontinued'") == R"("line continued")");
+    CHECK(json5::transcode_json(R"('\x41\v')") == R"("\u0041\u000b")");
+    CHECK(json5::transcode_json("'tab\there'") == R"("tab\u0009here")");
+    CHECK(json5::transcode_json(R"("\n\"\\")") == R"("\n\"\\")");
+}
+
+TEST_CASE("Transcode numbers") {
+    CHECK(json5::transcode_json("+1") == "1");
+    CHECK(json5::transcode_json(".5") == "0.5");
+    CHECK(json5::transcode_json("-.5") == "-0.5");
+    CHECK(json5::transcode_json("007") == "7");
+    CHECK(json5::transcode_json("0.25") == "0.25");
+
+    CHECK_THROWS_AS(json5::transcode_json("[NaN]"), json5::parse_error);
+    json5::transcode_options as_null{.nonfinite = json5::nonfinite_policy::null};
+    CHECK(json5::transcode_json("[NaN, Infinity]", json5::json5_options, as_null)
+          == "[null,null]");
+    json5::transcode_options as_string{.nonfinite = json5::nonfinite_policy::string};
+    CHECK(json5::transcode_json("[Infinity]", json5::json5_options, as_string)
+          == R"(["Infinity"])");
+}
+
+TEST_CASE("Transcode errors") {
+    CHECK_THROWS_AS(json5::transcode_json(""), json5::parse_error);
+    CHECK_THROWS_AS(json5::transcode_json("[1, 2"), json5::parse_error);
+    CHECK_THROWS_AS(json5::transcode_json("1 2"), json5::parse_error);
+    CHECK_THROWS_AS(json5::transcode_json("{a: 1,}", json5::jsonc_options), json5::parse_error);
+
+    std::string out;
+    json5::transcode_json("{a: [1]}",
+                          std::back_inserter(out),
+                          json5::json5_options,
+                          json5::transcode_options{});
+    CHECK(out == R"({"a":[1]})");
+}
@@ -0,0 +1,576 @@
+#include "./validate.hpp"
+
+#include <json5/unicode.hpp>
+
+#include <bitset>
+#include <new>
+#include <vector>
+
+using namespace json5;
+
+namespace {
+
+/*
+ * The validator is a tokenizer and parser fused into one loop over the bytes. It accepts
+ * exactly the same language as `tokenizer` and `parser` (including their quirks), and uses
+ * the same error messages, but never materializes a token or an event.
+ *
+ * Strings and comments, where most of the bytes of a typical document are, are scanned
+ * eight bytes at a time for the few bytes that are significant within them. Non-ASCII
+ * bytes are checked to be valid UTF-8 as they are reached.
+ */
+
+bool is_space(char c) noexcept { return c == ' ' || (c >= '\t' && c <= '\r'); }
+bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+bool is_ident_first(char c) noexcept {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$';
+}
+bool is_ident_char(char c) noexcept { return is_ident_first(c) || is_digit(c); }
+bool is_ascii(char c) noexcept { return static_cast<unsigned char>(c) < 0x80; }
+
+enum tok_kind {
+    t_invalid,
+    t_invalid_utf8,
+    t_unterm_string,
+    t_brace_open,
+    t_brace_close,
+    t_bracket_open,
+    t_bracket_close,
+    t_colon,
+    t_comma,
+    /// `null`, `true`, `false`, `Infinity`, `NaN`, or a number
+    t_literal,
+    /// A sign that is not followed by any digits
+    t_bad_number,
+    t_string,
+    t_identifier,
+    t_eof,
+};
+
+enum class state {
+    top,
+    top_done,
+    array_value_or_close,
+    array_value_after_comma,
+    array_tail,
+    object_key_or_close,
+    object_key_after_comma,
+    object_kv_colon,
+    object_value,
+    object_tail,
+};
+
+class validator {
+    const char* const   _begin;
+    const char* const   _end;
+    const parse_options _opts;
+
+    const char* _ptr = _begin;
+
+    // The current token
+    tok_kind    _kind            = t_invalid;
+    const char* _tok             = _begin;
+    bool        _squote          = false;
+    bool        _escaped_newline = false;
+
+    state             _state = state::top;
+    std::bitset<1024> _is_object;
+    std::size_t       _depth = 0;
+
+    /// The number of elements seen so far in the innermost open array/object, and those of
+    /// the enclosing ones. These are only tracked if `max_elements` is limited.
+    std::size_t              _elem_count = 0;
+    std::vector<std::size_t> _outer_elem_counts;
+    /// The number of values seen so far
+    std::size_t _n_values = 0;
+
+    validate_result _result;
+
+    bool _fail(const char* where, std::string_view reason) noexcept {
+        _result = {false, static_cast<std::size_t>(where - _begin), reason};
+        return false;
+    }
+
+    char _peek(std::size_t n) const noexcept {
+        return static_cast<std::size_t>(_end - _ptr) > n ? _ptr[n] : '\0';
+    }
+
+    /// The length of the UTF-8 sequence at the current position, or zero if it is invalid
+    std::size_t _utf8_len() const noexcept {
+        char32_t cp = 0;
+        return static_cast<std::size_t>(detail::utf8_decode(_ptr, _end, cp));
+    }
+
+    /// The length of the identifier character at the current position, or zero if none
+    std::size_t _ident_char_len(bool first) const noexcept {
+        if (_ptr == _end) {
+            return 0;
+        }
+        if (is_ascii(*_ptr)) {
+            return (first ? is_ident_first(*_ptr) : is_ident_char(*_ptr)) ? 1 : 0;
+        }
+        char32_t   cp  = 0;
+        const auto len = detail::utf8_decode(_ptr, _end, cp);
+        const bool ok
+            = first ? detail::is_unicode_id_start(cp) : detail::is_unicode_id_continue(cp);
+        return len != 0 && ok ? static_cast<std::size_t>(len) : 0;
+    }
+
+    /// Skip white-space and comments. Returns `false` on an invalid comment.
+    bool _skip_trivia() noexcept {
+        while (true) {
+            while (_ptr != _end && is_space(*_ptr)) {
+                ++_ptr;
+            }
+            if (_peek(0) != '/' || (_peek(1) != '/' && _peek(1) != '*')) {
+                return true;
+            }
+            const char* start = _ptr;
+            if (_opts.c_comments == toggle::off) {
+                return _fail(start, "Comments are not allowed.");
+            }
+            const bool line = _peek(1) == '/';
+            // As in the tokenizer, the `*` that opens a block comment may also close it
+            _ptr += line ? 2 : 1;
+            while (true) {
+                _ptr += line ? detail::ascii_run(_ptr, _end, '\n', '\r', '\n', '\r')
+                             : detail::ascii_run(_ptr, _end, '*', '*', '*', '*');
+                if (_ptr == _end) {
+                    if (!line) {
+                        return _fail(start, "Unterminated block comment");
+                    }
+                    break;
+                }
+                if (line && (*_ptr == '\n' || *_ptr == '\r')) {
+                    break;
+                }
+                if (!line && *_ptr == '*' && _peek(1) == '/') {
+                    _ptr += 2;
+                    break;
+                }
+                if (!is_ascii(*_ptr)) {
+                    const auto len = _utf8_len();
+                    if (len == 0) {
+                        return _fail(start, "Invalid UTF-8 in input");
+                    }
+                    _ptr += len;
+                    continue;
+                }
+                ++_ptr;
+            }
+        }
+    }
+
+    void _lex_string() noexcept {
+        const char quote = *_ptr++;
+        _squote          = quote == '\'';
+        _escaped_newline = false;
+        while (true) {
+            _ptr += detail::ascii_run(_ptr, _end, quote, '\\', '\n', '\r');
+            if (_ptr == _end) {
+                _kind = t_unterm_string;
+                return;
+            }
+            const char c = *_ptr;
+            if (!is_ascii(c)) {
+                const auto len = _utf8_len();
+                if (len == 0) {
+                    _kind = t_invalid_utf8;
+                    return;
+                }
+                _ptr += len;
+            } else if (c == '\\') {
+                ++_ptr;
+                if (_ptr == _end) {
+                    _kind = t_unterm_string;
+                    return;
+                }
+                _escaped_newline = _escaped_newline || *_ptr == '\n';
+                if (!is_ascii(*_ptr)) {
+                    const auto len = _utf8_len();
+                    if (len == 0) {
+                        _kind = t_invalid_utf8;
+                        return;
+                    }
+                    _ptr += len;
+                } else if (*_ptr == '\r' && _end - _ptr > 1 && _ptr[1] == '\n') {
+                    // An escaped CRLF is a single line continuation
+                    _escaped_newline = true;
+                    _ptr += 2;
+                } else {
+                    ++_ptr;
+                }
+            } else if (c == quote) {
+                ++_ptr;
+                _kind = t_string;
+                return;
+            } else if (c == '\n' || c == '\r') {
+                _kind = t_unterm_string;
+                return;
+            } else {
+                ++_ptr;
+            }
+        }
+    }
+
+    void _lex_number() noexcept {
+        _kind = t_literal;
+        if (*_ptr == '+' || *_ptr == '-') {
+            ++_ptr;
+            if (_ptr == _end) {
+                _kind = t_invalid;
+                return;
+            }
+        }
+        if (*_ptr == '.' && !is_digit(_peek(1))) {
+            ++_ptr;
+            _kind = t_invalid;
+            return;
+        }
+        const char* digits = _ptr;
+        while (_ptr != _end && is_digit(*_ptr)) {
+            ++_ptr;
+        }
+        if (_peek(0) == '.' && is_digit(_peek(1))) {
+            ++_ptr;
+            while (_ptr != _end && is_digit(*_ptr)) {
+                ++_ptr;
+            }
+        }
+        if (_ptr == digits) {
+            _kind = t_bad_number;
+        }
+    }
+
+    void _lex_ident() noexcept {
+        while (true) {
+            while (_ptr != _end && is_ident_char(*_ptr)) {
+                ++_ptr;
+            }
+            const auto len = _ident_char_len(false);
+            if (len == 0) {
+                break;
+            }
+            _ptr += len;
+        }
+        const std::string_view word(_tok, static_cast<std::size_t>(_ptr - _tok));
+        if (word == "null" || word == "true" || word == "false" || word == "Infinity"
+            || word == "NaN") {
+            _kind = t_literal;
+        } else {
+            _kind = t_identifier;
+        }
+    }
+
+    /// Read the next token. Returns `false` on an invalid comment.
+    bool _lex() noexcept {
+        if (!_skip_trivia()) {
+            return false;
+        }
+        _tok = _ptr;
+        if (_ptr == _end) {
+            _kind = t_eof;
+            return true;
+        }
+        const char c = *_ptr;
+        switch (c) {
+        case '{':
+            _kind = t_brace_open;
+            break;
+        case '}':
+            _kind = t_brace_close;
+            break;
+        case '[':
+            _kind = t_bracket_open;
+            break;
+        case ']':
+            _kind = t_bracket_close;
+            break;
+        case ':':
+            _kind = t_colon;
+            break;
+        case ',':
+            _kind = t_comma;
+            break;
+        case '"':
+        case '\'':
+            _lex_string();
+            if (_kind == t_invalid_utf8) {
+                return _fail(_tok, "Invalid UTF-8 in input");
+            }
+            return true;
+        default:
+            if (is_ident_first(c)) {
+                ++_ptr;
+                _lex_ident();
+            } else if (const auto ident_len = _ident_char_len(true)) {
+                _ptr += ident_len;
+                _lex_ident();
+            } else if (!is_ascii(c)) {
+                const auto len = _utf8_len();
+                if (len == 0) {
+                    return _fail(_tok, "Invalid UTF-8 in input");
+                }
+                _ptr += len;
+                _kind = t_invalid;
+            } else if (is_digit(c) || c == '.' || c == '+' || c == '-') {
+                _lex_number();
+            } else {
+                ++_ptr;
+                _kind = t_invalid;
+            }
+            return true;
+        }
+        ++_ptr;
+        return true;
+    }
+
+    bool _check_string() noexcept {
+        if (_opts.single_quote_strings == toggle::off && _squote) {
+            return _fail(_tok, "Single-quote strings are not allowed.");
+        }
+        if (_opts.escape_newline_strings == toggle::off && _escaped_newline) {
+            return _fail(_tok, "Escaped newlines in strings are not allowed.");
+        }
+        return _check_length(static_cast<std::size_t>(_ptr - _tok) - 2);
+    }
+
+    bool _check_length(std::size_t len) noexcept {
+        if (len > _opts.limits.max_string_length) {
+            return _fail(_tok, "String exceeds the length limit");
+        }
+        return true;
+    }
+
+    bool _counts_elements() const noexcept { return _opts.limits.max_elements != SIZE_MAX; }
+
+    /// Count a new value against the limits
+    bool _count_value() noexcept {
+        if (++_n_values > _opts.limits.max_nodes) {
+            return _fail(_tok, "Document exceeds the value limit");
+        }
+        if (_counts_elements() && _depth && ++_elem_count > _opts.limits.max_elements) {
+            return _fail(_tok, "Array/object exceeds the element limit");
+        }
+        return true;
+    }
+
+    void _after_value() noexcept {
+        if (_depth == 0) {
+            _state = state::top_done;
+        } else {
+            _state = _is_object[_depth - 1] ? state::object_tail : state::array_tail;
+        }
+    }
+
+    bool _open(bool is_object) noexcept {
+        if (_depth == _is_object.size() || _depth >= _opts.limits.max_depth) {
+            return _fail(_tok, "Array/object nesting is too deep.");
+        }
+        if (!_count_value()) {
+            return false;
+        }
+        if (_counts_elements()) {
+            try {
+                _outer_elem_counts.push_back(_elem_count);
+            } catch (const std::bad_alloc&) {
+                return _fail(_tok, "Out of memory for array/object nesting");
+            }
+            _elem_count = 0;
+        }
+        _is_object[_depth++] = is_object;
+        _state = is_object ? state::object_key_or_close : state::array_value_or_close;
+        return true;
+    }
+
+    void _close() noexcept {
+        --_depth;
+        if (_counts_elements()) {
+            _elem_count = _outer_elem_counts.back();
+            _outer_elem_counts.pop_back();
+        }
+        _after_value();
+    }
+
+    bool _value() noexcept {
+        switch (_kind) {
+        case t_literal:
+            if (!_count_value()) {
+                return false;
+            }
+            _after_value();
+            return true;
+        case t_bad_number:
+            return _fail(_tok, "Invalid number literal");
+        case t_string:
+            if (!_check_string() || !_count_value()) {
+                return false;
+            }
+            _after_value();
+            return true;
+        case t_bracket_open:
+            return _open(false);
+        case t_brace_open:
+            return _open(true);
+        case t_eof:
+            return _fail(_tok, "Unexpected end-of-input: Expected a value");
+        case t_identifier:
+            return _fail(_tok, "An object key identifier is not a valid value.");
+        case t_bracket_close:
+            return _fail(_tok, "Unexpected closing `]`");
+        case t_brace_close:
+            return _fail(_tok, "Unexpected closing `}`");
+        case t_unterm_string:
+            return _fail(_tok, "Unterminated string");
+        case t_colon:
+            return _fail(_tok, "Unexpected `:`");
+        case t_comma:
+            if (_depth == 0) {
+                return _fail(_tok, "Unexpected `,`");
+            } else if (_is_object[_depth - 1]) {
+                return _fail(_tok, "Expected value before `,` in object literal.");
+            } else {
+                return _fail(_tok, "Extraneous `,` in array literal.");
+            }
+        case t_invalid:
+        default:
+            return _fail(_tok, "Invalid token");
+        }
+    }
+
+    bool _object_key(bool after_comma) noexcept {
+        switch (_kind) {
+        case t_brace_close:
+            if (after_comma) {
+                return _fail(_tok, "Trailing commas are not allowed: Expected an object key.");
+            }
+            _close();
+            return true;
+        case t_identifier:
+            if (_opts.bare_ident_keys == toggle::off) {
+                return _fail(_tok, "Bare identifier object keys are not allowed.");
+            }
+            if (!_check_length(static_cast<std::size_t>(_ptr - _tok))) {
+                return false;
+            }
+            _state = state::object_kv_colon;
+            return true;
+        case t_string:
+            if (!_check_string()) {
+                return false;
+            }
+            _state = state::object_kv_colon;
+            return true;
+        case t_eof:
+            return _fail(_tok, "Unterminated object literal");
+        case t_literal:
+        case t_bad_number:
+        case t_brace_open:
+        case t_bracket_open:
+            if (_opts.bare_ident_keys == toggle::on) {
+                return _fail(_tok, "Object member keys must be strings or identifiers.");
+            } else {
+                return _fail(_tok, "Object member keys must be strings.");
+            }
+        case t_comma:
+            return _fail(_tok, "Extraneous `,` in object literal.");
+        default:
+            return _fail(_tok, "Expected an object member or closing brace `}`");
+        }
+    }
+
+    bool _step() noexcept {
+        switch (_state) {
+        case state::top:
+            if (_kind == t_eof) {
+                return _fail(_tok, "Unexpected end-of-input");
+            }
+            return _value();
+        case state::top_done:
+            return _fail(_tok, "Trailing characters in JSON data");
+        case state::array_value_or_close:
+            if (_kind == t_bracket_close) {
+                _close();
+                return true;
+            } else if (_kind == t_eof) {
+                return _fail(_tok, "Unterminated array literal");
+            }
+            return _value();
+        case state::array_value_after_comma:
+            if (_kind == t_bracket_close) {
+                return _fail(_tok, "Trailing commas are not allowed: Expected an array value.");
+            }
+            return _value();
+        case state::array_tail:
+            switch (_kind) {
+            case t_bracket_close:
+                _close();
+                return true;
+            case t_comma:
+                _state = _opts.trailing_commas == toggle::on ? state::array_value_or_close
+                                                             : state::array_value_after_comma;
+                return true;
+            case t_eof:
+                return _fail(_tok, "Unterminated array literal");
+            default:
+                return _fail(_tok, "Expected `,` or `]` in array");
+            }
+        case state::object_key_or_close:
+            return _object_key(false);
+        case state::object_key_after_comma:
+            return _object_key(true);
+        case state::object_kv_colon:
+            if (_kind != t_colon) {
+                return _fail(_tok, "Expected `:` following object member key");
+            }
+            _state = state::object_value;
+            return true;
+        case state::object_value:
+            return _value();
+        case state::object_tail:
+            switch (_kind) {
+            case t_comma:
+                _state = _opts.trailing_commas == toggle::on ? state::object_key_or_close
+                                                             : state::object_key_after_comma;
+                return true;
+            case t_brace_close:
+                _close();
+                return true;
+            case t_eof:
+                return _fail(_tok, "Unterminated object literal");
+            default:
+                return _fail(_tok, "Expected `,` or `}` in object");
+            }
+        }
+        return _fail(_tok, "Invalid validator state");
+    }
+
+public:
+    validator(std::string_view str, parse_options opts) noexcept
+        : _begin(str.data())
+        , _end(str.data() + str.size())
+        , _opts(opts) {}
+
+    validate_result run() noexcept {
+        if (static_cast<std::size_t>(_end - _begin) > _opts.limits.max_bytes) {
+            _fail(_begin, "Input exceeds the size limit");
+            return _result;
+        }
+        while (_lex() && _step()) {
+            if (_state == state::top_done) {
+                // Only trailing trivia may follow the top-level value
+                if (_lex() && _kind != t_eof) {
+                    _fail(_tok, "Trailing characters in JSON data");
+                }
+                break;
+            }
+        }
+        return _result;
+    }
+};
+
+}  // namespace
+
+validate_result json5::validate(std::string_view str, parse_options opts) {
+    return validator{str, opts}.run();
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <json5/parse.hpp>
+
+#include <cstddef>
+#include <string_view>
+
+namespace json5 {
+
+/**
+ * The result of validating a document. On failure, `offset` is the byte offset of the
+ * start of the token at which the error was found, and `reason` is a static message.
+ */
+struct validate_result {
+    bool             ok     = true;
+    std::size_t      offset = 0;
+    std::string_view reason;
+
+    explicit operator bool() const noexcept { return ok; }
+};
+
+/**
+ * Check whether the given document is well-formed under the given options, without
+ * tokenizing it or generating parse events. A document is accepted exactly when
+ * `parse_data()` would accept its syntax. Number values are not range-checked.
+ */
+validate_result validate(std::string_view str, parse_options opts);
+
+inline validate_result validate(std::string_view str) { return validate(str, parse_options{}); }
+
+}  // namespace json5
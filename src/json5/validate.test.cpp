@@ -0,0 +1,203 @@
+#include <json5/validate.hpp>
+
+#include <json5/parse_data.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <string>
+
+namespace {
+
+bool parses(std::string_view str, json5::parse_options opts) {
+    try {
+        json5::parse_data(str, opts);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+const json5::parse_options all_options[] = {
+    json5::json5_options,
+    json5::jsonc_options,
+    json5::json_strict_options,
+};
+
+}  // namespace
+
+TEST_CASE("Validate documents") {
+    CHECK(json5::validate("{a: [1, 'two', null, true, .5, +3, Infinity], 'b': {},}"));
+    CHECK(json5::validate("  // comment\n 42 /* trailing */ "));
+    CHECK(json5::validate(R"({"a": [1, 2, "three"]})", json5::json_strict_options));
+
+    auto res = json5::validate("{a: 1, b: [1, 2 3]}");
+    CHECK_FALSE(res);
+    CHECK(res.offset == 16);
+    CHECK(res.reason == "Expected `,` or `]` in array");
+
+    res = json5::validate("[1, 2,]", json5::jsonc_options);
+    CHECK(res.offset == 6);
+    CHECK(res.reason == "Trailing commas are not allowed: Expected an array value.");
+
+    res = json5::validate("'this string runs on and on and on", json5::json5_options);
+    CHECK(res.offset == 0);
+    CHECK(res.reason == "Unterminated string");
+
+    res = json5::validate("[1] // ok\n /* not ok", json5::json5_options);
+    CHECK(res.offset == 11);
+    CHECK(res.reason == "Unterminated block comment");
+
+    res = json5::validate(std::string(1025, '['));
+    CHECK(res.offset == 1024);
+    CHECK(res.reason == "Array/object nesting is too deep.");
+}
+
+TEST_CASE("Validation agrees with parse_data") {
+    const char* corpus[] = {
+        "",
+        "null",
+        "nul",
+        "nullx",
+        "foo",
+        "[-]",
+        "[-.]",
+        "[+]",
+        "+",
+        "[1.]",
+        "1.5.5",
+        "[.5, 5., -.5]",
+        "[1true]",
+        "{a 1}",
+        "{a: 1,}",
+        "{a: 1,,}",
+        "{,}",
+        "[,]",
+        "[1,,]",
+        "{null: 1}",
+        "{Infinity: 1}",
+        "{1: 1}",
+        "{[]: 1}",
+        "{'a': 1}",
+        "{a: 1} {}",
+        "[1] 2",
+        "[1] @",
+        "'a\\\nb'",
+        "'a\\\r\nb'",
+        "'a\nb'",
+        "'a\\'",
+        "'\\",
+        "\"\\\"\"",
+        "/ 1",
+        "1 //",
+        "/**/1/**/",
+        "/*/ 1",
+        "/* * / */ 1",
+        "[1, /* , */ 2]",
+        "{a: 1 b: 2}",
+        "{a: 1: 2}",
+        "{a:}",
+        "}",
+        "]",
+        ":",
+        ",",
+        "[\"\x80\xff\"]",
+        "[\x80]",
+        "{$_a1: 'x'}",
+        "\v\f\t\r\n 0 \n",
+        "[[[[[]]]]]",
+        "[[[[[]]]]",
+        "{a: {b: {c: [1, {d: 'e'}]}}}",
+        "{ünïcödé: 'ßnow ☃', Ωmega_2: 1}",
+        "{́x: 1}",
+        "{x́: 1}",
+        "['caf\xc3']",
+        "['\\\xc3']",
+        "['\\é']",
+        "// \xed\xa0\x80\n1",
+        "/* \xf4\x90\x80\x80 */ 1",
+        "[\xc3\xa9]",
+        "[☃]",
+        "1 \xff",
+    };
+    for (auto str : corpus) {
+        for (auto opts : all_options) {
+            INFO("Input: " << str);
+            CHECK(json5::validate(str, opts).ok == parses(str, opts));
+        }
+    }
+}
+
+TEST_CASE("Validation applies resource limits") {
+    struct limit_case {
+        const char*         str;
+        json5::parse_limits limits;
+    };
+    const limit_case cases[] = {
+        {"[1, 2, 3] ", {.max_bytes = 9}},
+        {"[1, 2, 3]", {.max_bytes = 9}},
+        {"[[[[]]]]", {.max_depth = 3}},
+        {"[[[]]]", {.max_depth = 3}},
+        {"['abcd']", {.max_string_length = 3}},
+        {"{abcd: 1}", {.max_string_length = 3}},
+        {"{'abc': 'abc'}", {.max_string_length = 3}},
+        {"[1, 2, 3]", {.max_elements = 2}},
+        {"[{a: 1, b: 2, c: 3}]", {.max_elements = 2}},
+        {"[[1, 2], {a: 1, b: 2}]", {.max_elements = 2}},
+        {"[[1, 2], [3, 4], 5]", {.max_elements = 2}},
+        {"[1, [2], {a: 3}, 4]", {.max_nodes = 6}},
+        {"[1, [2], {a: 3}]", {.max_nodes = 6}},
+    };
+    for (const auto& c : cases) {
+        INFO("Input: " << c.str);
+        json5::parse_options opts = json5::json5_options;
+        opts.limits               = c.limits;
+        const auto res            = json5::validate(c.str, opts);
+
+        std::string error;
+        try {
+            json5::parse_data(c.str, opts);
+        } catch (const json5::parse_error& e) {
+            error = e.what();
+        }
+        CHECK(res.ok == error.empty());
+        if (!res.ok) {
+            CHECK_THAT(error, Catch::Contains(std::string(res.reason)));
+        }
+    }
+}
+
+TEST_CASE("Validation agrees with parse_data on mutated documents") {
+    const std::string seed = R"({
+    // A comment with "quotes" and 'more'
+    name: 'the name', "other": "with \"escapes\" and a \
+continuation", ünïcödé: 'ßnow ☃',
+    list: [1, -2.5, .5, +7, Infinity, NaN, null, true, false,],
+    /* block */ nested: {a: [], b: {}, c: [[{}]]},
+})";
+    const char   alphabet[] = "{}[]:,'\"\\/*\n\r .+-0aN_$x\x80";
+    std::mt19937 rng{1729};
+    for (int i = 0; i < 5000; ++i) {
+        auto doc = seed;
+        for (int n = std::uniform_int_distribution<int>{1, 3}(rng); n != 0; --n) {
+            const auto pos = std::uniform_int_distribution<std::size_t>{0, doc.size() - 1}(rng);
+            const char c   = alphabet[std::uniform_int_distribution<std::size_t>{
+                0, sizeof alphabet - 2}(rng)];
+            switch (rng() % 3) {
+            case 0:
+                doc[pos] = c;
+                break;
+            case 1:
+                doc.insert(doc.begin() + static_cast<std::ptrdiff_t>(pos), c);
+                break;
+            default:
+                doc.erase(pos, 1);
+                break;
+            }
+        }
+        for (auto opts : all_options) {
+            INFO("Input: " << doc);
+            REQUIRE(json5::validate(doc, opts).ok == parses(doc, opts));
+        }
+    }
+}